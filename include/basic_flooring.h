@@ -0,0 +1,1025 @@
+#ifndef BASIC_FLOORING_H
+#define BASIC_FLOORING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "expected.h"
+#include "flooring_policies.h"
+#include "leftover_inventory.h"
+#include "plank.h"
+#include "random_generator.h"
+#include "raylib.h"
+#include "units.h"
+
+inline constexpr size_t DEFAULT_CHUNK_SIZE = 4096;
+
+// random lengths are drawn a block per row as every row reseeds, or with FLOORING_COUNTER_RANDOM straight from a
+// counter based generator keyed by the seed, the row and the cut
+#ifdef FLOORING_COUNTER_RANDOM
+using LengthRandom = CounterRandom;
+#else
+using LengthRandom = BatchedRandom<16>;
+#endif
+
+struct Result
+{
+    int all_planks;
+    int left_over;
+    int uncut;
+    std::vector<Plank> planks;
+    // left over pieces sit at the origin, left_over_positions holds where they are shown below the room; that area
+    // grows with the number of pieces, so it is kept in Length even when planks store packed coordinates
+    std::vector<Plank> left_over_pieces;
+    // calculating the configuration with this seed gives the same layout again
+    std::uint64_t seed = 0;
+    std::vector<std::pair<Length, Length>> left_over_positions{};
+};
+
+// receives the planks of a streaming calculation in row order, one chunk at a time
+using PlankSink = std::function<void(const std::vector<Plank>&)>;
+
+// everything a calculation depends on, Flooring picks the policies from the two switches
+struct FlooringConfig
+{
+    std::pair<Length, Length> room_size{ 0, 0 };
+    std::pair<Length, Length> plank_size{ 0, 0 };
+    bool staggered = true;
+    bool randomize_lengths = false;
+    // random lengths move their seams at least this far from the joints of the row below; where no length of the
+    // plank can clear them the random length is kept, LayoutMetrics::close_joints counts those seams
+    Length min_joint_spacing = 0;
+    // the same seed always gives the same layout, a random one is drawn for every run when empty
+    std::optional<std::uint64_t> seed{};
+};
+
+enum class FlooringError
+{
+    non_positive_size,
+    negative_joint_spacing,
+    plank_shorter_than_min_length,
+    stagger_outside_plank,
+    stagger_wider_than_room,
+    size_beyond_plank_coordinates,
+    cancelled
+};
+
+[[nodiscard]] inline auto describe(FlooringError error) -> const char*
+{
+    switch (error)
+    {
+    case FlooringError::non_positive_size:
+        return "Room and plank sizes must be positive.";
+    case FlooringError::negative_joint_spacing:
+        return "The joint spacing cannot be negative.";
+    case FlooringError::plank_shorter_than_min_length:
+        return "The plank is shorter than the shortest random length.";
+    case FlooringError::stagger_outside_plank:
+        return "A stagger offset does not fit on the plank.";
+    case FlooringError::stagger_wider_than_room:
+        return "A stagger offset is wider than the room.";
+    case FlooringError::size_beyond_plank_coordinates:
+        return "The room or the plank is too large for the packed plank coordinates of this build.";
+    case FlooringError::cancelled:
+        return "The calculation was cancelled.";
+    }
+    return "Unknown error.";
+}
+
+using FlooringResult = Expected<Result, FlooringError>;
+
+struct Progress
+{
+    size_t rows_done;
+    size_t rows_total;
+    // planks opened so far
+    int planks_used;
+};
+
+// called on the thread that runs the calculation, at the start of every row and once at the end
+using ProgressCallback = std::function<void(const Progress&)>;
+
+// Shared between the caller and a running calculation, which stops at the next row boundary once cancelled.
+// reset() may only be called while no calculation uses the token.
+class CancellationToken
+{
+public:
+    void cancel()
+    {
+        cancelled_.store(true, std::memory_order_relaxed);
+    }
+    void reset()
+    {
+        cancelled_.store(false, std::memory_order_relaxed);
+    }
+    [[nodiscard]] auto is_cancelled() const -> bool
+    {
+        return cancelled_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<bool> cancelled_{ false };
+};
+
+// engine state at the start of a row
+struct RowCheckpoint
+{
+    std::pair<Length, Length> position;
+    size_t row;
+    int index;
+    int uncut_planks;
+    size_t plank_count;
+    std::vector<Plank> left_over_pieces;
+    std::vector<Length> previous_row_joints;
+};
+
+// All the mutable state of a calculation. The caller owns it, so any number of threads can run calculations
+// at the same time, each in its own workspace. Reusing a workspace keeps its buffers allocated.
+struct Workspace
+{
+    // seed of the layout in the workspace, drawn by every full run that has none in its configuration; random
+    // lengths come from a stream per row of it, so rows can be cut in parallel
+    std::uint64_t seed = 0;
+    LengthRandom row_random{};
+
+    std::pair<Length, Length> current_position{ 0, 0 };
+    size_t row = 0;
+    int index = 0;
+    int uncut_planks = 0;
+
+    // joint x positions in increasing order, used to keep random cuts away from the seams of the row below
+    std::vector<Length> previous_row_joints{};
+    std::vector<Length> current_row_joints{};
+
+    std::vector<Plank> planks{};
+    std::vector<Plank> left_over_pieces{};
+
+    // cuts of every row, filled by the first phase of a parallel calculation
+    std::vector<std::vector<std::pair<Length, Length>>> planned_rows{};
+
+    // configuration of the last full run, what recalculate() resumes from
+    std::optional<FlooringConfig> calculated_config{};
+    std::optional<RowCheckpoint> last_row_checkpoint{};
+
+    // optional, set by the caller; a cancelled run returns FlooringError::cancelled and cannot be resumed
+    ProgressCallback progress{};
+    const CancellationToken* cancellation = nullptr;
+
+    // optional stock of offcuts from earlier jobs, cuts are taken from it when the leftovers of this job do not fit
+    // and the leftovers are put into it when a calculate call completes; meant for one call per real job, so
+    // recalculating a run of this workspace leaves it alone
+    LeftoverInventory* inventory = nullptr;
+};
+
+// Layout engine with the stagger, length and leftover matching behaviour fixed at compile time,
+// so the per plank loop has no runtime switches. Flooring picks the specialisation at runtime.
+// The engine itself holds no state, everything a run changes lives in the workspace.
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+class BasicFlooring
+{
+public:
+    // checks in constant time that the layout loop cannot run off the room or the plank with this configuration
+    [[nodiscard]] static auto validate(const FlooringConfig& config) -> std::optional<FlooringError>;
+
+    // the calculations validate the configuration first and leave the workspace alone when it is rejected,
+    // they report progress and check for cancellation at row boundaries through the hooks of the workspace
+
+    [[nodiscard]] static auto calculate(const FlooringConfig& config, Workspace& workspace) -> FlooringResult;
+
+    // streams the planks to the sink instead of keeping them, the returned result has no planks
+    [[nodiscard]] static auto calculate(
+        const FlooringConfig& config,
+        Workspace& workspace,
+        const PlankSink& sink,
+        size_t chunk_size = DEFAULT_CHUNK_SIZE) -> FlooringResult;
+
+    // Same result as calculate(), in two phases: the cuts of every row are worked out on up to thread_count threads,
+    // 0 uses all cores, then the cuts are matched against the leftovers in row order. Random lengths with a joint
+    // spacing depend on the row below, those rows are cut on the calling thread.
+    [[nodiscard]] static auto calculate_parallel(
+        const FlooringConfig& config,
+        Workspace& workspace,
+        unsigned thread_count = 0) -> FlooringResult;
+
+    // reuses the rows of the previous run in the workspace that are not affected by a change of the room depth,
+    // falls back to a full calculation with the same seed for any other change; the inventory already holds the
+    // outcome of the previous run, so the redone rows neither take pieces from it nor put leftovers into it
+    [[nodiscard]] static auto recalculate(const FlooringConfig& config, Workspace& workspace) -> FlooringResult;
+
+    // step by step calculation: start(), then place_next_plank() while has_next_plank(), then summary(),
+    // the configuration has to pass validate()
+    static void start(const FlooringConfig& config, Workspace& workspace);
+    [[nodiscard]] static auto has_next_plank(const FlooringConfig& config, const Workspace& workspace) -> bool;
+    [[nodiscard]] static auto place_next_plank(const FlooringConfig& config, Workspace& workspace) -> Plank;
+    [[nodiscard]] static auto summary(const FlooringConfig& config, Workspace& workspace) -> Result;
+
+private:
+    static void seed(const FlooringConfig& config, Workspace& workspace);
+    [[nodiscard]] static auto run(const FlooringConfig& config, Workspace& workspace) -> FlooringResult;
+    [[nodiscard]] static auto row_count(const FlooringConfig& config) -> size_t;
+    static void report_progress(const FlooringConfig& config, const Workspace& workspace);
+    [[nodiscard]] static auto start_row(const FlooringConfig& config, Workspace& workspace) -> bool;
+    [[nodiscard]] static auto calculate_slice(const FlooringConfig& config, Workspace& workspace)
+        -> std::pair<Length, Length>;
+    [[nodiscard]] static auto find_conflicting_joint(
+        const FlooringConfig& config,
+        const Workspace& workspace,
+        Length joint) -> std::optional<Length>;
+    [[nodiscard]] static auto space_random_slice(
+        const FlooringConfig& config,
+        const Workspace& workspace,
+        Length slice,
+        Length min_slice) -> Length;
+
+    static void increment_position(
+        const FlooringConfig& config,
+        Workspace& workspace,
+        const std::pair<Length, Length>& offset);
+
+    [[nodiscard]] static auto place_slice(
+        const FlooringConfig& config,
+        Workspace& workspace,
+        const std::pair<Length, Length>& slice) -> Plank;
+    static void plan_rows(
+        const FlooringConfig& config,
+        std::uint64_t seed,
+        size_t first_row,
+        size_t last_row,
+        const CancellationToken* cancellation,
+        std::vector<std::vector<std::pair<Length, Length>>>& planned_rows);
+
+    static void reset(Workspace& workspace);
+    static void save_last_row_checkpoint(const FlooringConfig& config, Workspace& workspace);
+    [[nodiscard]] static auto fill_rows(const FlooringConfig& config, Workspace& workspace) -> bool;
+    [[nodiscard]] static auto resume(const FlooringConfig& config, Workspace& workspace) -> bool;
+    [[nodiscard]] static auto make_result(const FlooringConfig& config, Workspace& workspace) -> Result;
+
+    static void cleanup_left_over_pieces(Workspace& workspace);
+    [[nodiscard]] static auto left_over_positions(const FlooringConfig& config, size_t count)
+        -> std::vector<std::pair<Length, Length>>;
+
+    [[nodiscard]] static auto find_usable_piece(
+        Workspace& workspace,
+        bool is_sliced_horizontally,
+        bool is_sliced_vertically,
+        const std::pair<Length, Length>& size_lookup) -> std::optional<Plank>;
+    [[nodiscard]] static auto take_inventory_piece(
+        Workspace& workspace,
+        bool is_sliced_horizontally,
+        bool is_sliced_vertically,
+        const std::pair<Length, Length>& size_lookup) -> std::optional<Plank>;
+    static void close_inventory(Workspace& workspace, bool completed);
+};
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+void BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::seed(const FlooringConfig& config, Workspace& workspace)
+{
+    workspace.seed = config.seed ? *config.seed : random_seed();
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::validate(const FlooringConfig& config)
+    -> std::optional<FlooringError>
+{
+    const auto& room_size = config.room_size;
+    const auto& plank_size = config.plank_size;
+    if (room_size.first <= 0 || room_size.second <= 0 || plank_size.first <= 0 || plank_size.second <= 0)
+    {
+        return FlooringError::non_positive_size;
+    }
+    if (room_size.first > MAX_PLANK_COORDINATE || room_size.second > MAX_PLANK_COORDINATE ||
+        plank_size.first > MAX_PLANK_COORDINATE || plank_size.second > MAX_PLANK_COORDINATE)
+    {
+        return FlooringError::size_beyond_plank_coordinates;
+    }
+    if (config.min_joint_spacing < 0)
+    {
+        return FlooringError::negative_joint_spacing;
+    }
+    if (LengthPolicy::randomized && plank_size.first < LengthPolicy::min_length)
+    {
+        return FlooringError::plank_shorter_than_min_length;
+    }
+
+    // the row starts repeat, so one period of the rows that exist covers all of them
+    const auto rows = static_cast<size_t>((room_size.second + plank_size.second - 1) / plank_size.second);
+    for (size_t row = 0; row < std::min(rows, StaggerPolicy::period); row++)
+    {
+        const auto start = StaggerPolicy::row_start(row, plank_size.first);
+        if (start < 0 || start >= plank_size.first)
+        {
+            return FlooringError::stagger_outside_plank;
+        }
+        // random rows cut their first piece to fit
+        if (!LengthPolicy::randomized && start > room_size.first)
+        {
+            return FlooringError::stagger_wider_than_room;
+        }
+    }
+    return std::nullopt;
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::calculate_slice(
+    const FlooringConfig& config,
+    Workspace& workspace) -> std::pair<Length, Length>
+{
+    const auto& room_size = config.room_size;
+    const auto& plank_size = config.plank_size;
+    const auto& position = workspace.current_position;
+    std::pair<Length, Length> slice{ 0, 0 };
+
+    if constexpr (LengthPolicy::randomized)
+    {
+        if (position.first == 0)
+        {
+            seed_row(workspace.row_random, workspace.seed, workspace.row);
+        }
+    }
+
+    if (StaggerPolicy::staggered && position.first == 0)
+    {
+        slice.first = StaggerPolicy::row_start(workspace.row, plank_size.first);
+
+        // random rows only use the stagger as a starting point, the first seam still has to clear the row below
+        if constexpr (LengthPolicy::randomized)
+        {
+            const auto spaced =
+                space_random_slice(config, workspace, (slice.first > 0) ? slice.first : plank_size.first, 1);
+            slice.first = (spaced < plank_size.first) ? std::min(spaced, room_size.first) : 0;
+        }
+
+        // a row starting with a full plank cuts it to the room when the room is narrower
+        if (slice.first == 0 && plank_size.first > room_size.first)
+        {
+            slice.first = room_size.first;
+        }
+    }
+    else if ((position.first + plank_size.first) > room_size.first)
+    {
+        slice.first = room_size.first - position.first;
+    }
+    else if constexpr (LengthPolicy::randomized)
+    {
+        slice.first = space_random_slice(
+            config, workspace, LengthPolicy::draw(workspace.row_random, plank_size.first), LengthPolicy::min_length);
+
+        // clamp the random value
+        if ((position.first + slice.first) > room_size.first)
+        {
+            slice.first = slice.first - ((position.first + slice.first) - room_size.first);
+        }
+    }
+
+    if ((position.second + plank_size.second) > room_size.second)
+    {
+        slice.second = room_size.second - position.second;
+    }
+
+    return slice;
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::find_conflicting_joint(
+    const FlooringConfig& config,
+    const Workspace& workspace,
+    Length joint) -> std::optional<Length>
+{
+    const auto spacing = config.min_joint_spacing;
+    if (spacing <= 0 || joint >= config.room_size.first)
+    {
+        return std::nullopt;
+    }
+
+    // first joint of the previous row that is closer than the minimum spacing on either side
+    const auto& joints = workspace.previous_row_joints;
+    const auto candidate = std::lower_bound(begin(joints), end(joints), joint - spacing + 1);
+    if (candidate != end(joints) && *candidate < joint + spacing)
+    {
+        return *candidate;
+    }
+    return std::nullopt;
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::space_random_slice(
+    const FlooringConfig& config,
+    const Workspace& workspace,
+    Length slice,
+    Length min_slice) -> Length
+{
+    const auto row_position = workspace.current_position.first;
+
+    // try to move the joint to the right of the conflicting joints first, the plank is long enough most of the time
+    auto joint = row_position + slice;
+    for (auto conflict = find_conflicting_joint(config, workspace, joint); conflict;
+         conflict = find_conflicting_joint(config, workspace, joint))
+    {
+        joint = *conflict + config.min_joint_spacing;
+    }
+    if (joint - row_position <= config.plank_size.first)
+    {
+        return joint - row_position;
+    }
+
+    joint = row_position + slice;
+    for (auto conflict = find_conflicting_joint(config, workspace, joint); conflict;
+         conflict = find_conflicting_joint(config, workspace, joint))
+    {
+        joint = *conflict - config.min_joint_spacing;
+    }
+    if (joint - row_position >= min_slice)
+    {
+        return joint - row_position;
+    }
+
+    // the constraint cannot be met with this plank, keep the random length and leave the seam to the metrics
+    return slice;
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+void BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::increment_position(
+    const FlooringConfig& config,
+    Workspace& workspace,
+    const std::pair<Length, Length>& offset)
+{
+    auto& position = workspace.current_position;
+    position.first += offset.first;
+    if (position.first < config.room_size.first)
+    {
+        workspace.current_row_joints.push_back(position.first);
+    }
+    else
+    {
+        std::swap(workspace.previous_row_joints, workspace.current_row_joints);
+        workspace.current_row_joints.clear();
+
+        position.second += offset.second;
+        position.first = 0;
+        workspace.row++;
+    }
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+void BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::cleanup_left_over_pieces(Workspace& workspace)
+{
+    auto& pieces = workspace.left_over_pieces;
+    pieces.erase(
+        std::remove_if(
+            pieces.begin(),
+            pieces.end(),
+            [](const auto& p) { return p.dimensions_.first <= 0 || p.dimensions_.second <= 0; }),
+        pieces.end());
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::left_over_positions(
+    const FlooringConfig& config,
+    size_t count) -> std::vector<std::pair<Length, Length>>
+{
+    std::vector<std::pair<Length, Length>> positions;
+    positions.reserve(count);
+    Length left_over_col = 0;
+    Length left_over_row = 1;
+    static constexpr Length left_over_offset = 100;
+    for (size_t i = 0; i < count; i++)
+    {
+        positions.emplace_back(
+            left_over_col * (config.plank_size.first + left_over_offset),
+            config.room_size.second + (left_over_row * (config.plank_size.second + left_over_offset)));
+        left_over_col++;
+        if (left_over_col > 4)
+        {
+            left_over_col = 0;
+            left_over_row++;
+        }
+    }
+    return positions;
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::find_usable_piece(
+    Workspace& workspace,
+    bool is_sliced_horizontally,
+    bool is_sliced_vertically,
+    const std::pair<Length, Length>& size_lookup) -> std::optional<Plank>
+{
+    auto& pieces = workspace.left_over_pieces;
+    auto piece = MatchPolicy::find(begin(pieces), end(pieces), size_lookup);
+    if (piece == std::end(pieces))
+    {
+        return std::nullopt;
+    }
+
+    if (is_sliced_horizontally)
+    {
+        (*piece).dimensions_.second -= size_lookup.second;
+    }
+    if (is_sliced_vertically)
+    {
+        (*piece).dimensions_.first -= size_lookup.first;
+    }
+
+    return Plank{ (*piece).id_, workspace.current_position, size_lookup };
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::take_inventory_piece(
+    Workspace& workspace,
+    bool is_sliced_horizontally,
+    bool is_sliced_vertically,
+    const std::pair<Length, Length>& size_lookup) -> std::optional<Plank>
+{
+    const auto piece = workspace.inventory->take(size_lookup);
+    if (!piece)
+    {
+        return std::nullopt;
+    }
+
+    // the rest of the piece joins the leftovers of this job, like the rest of a new plank
+    const auto id = -static_cast<int>(piece->serial);
+    auto rest = piece->dimensions;
+    if (is_sliced_horizontally)
+    {
+        rest.second -= size_lookup.second;
+    }
+    if (is_sliced_vertically)
+    {
+        rest.first -= size_lookup.first;
+    }
+    workspace.left_over_pieces.emplace_back(id, std::pair<Length, Length>{ 0, 0 }, rest);
+
+    return Plank{ id, workspace.current_position, size_lookup };
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+void BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::close_inventory(Workspace& workspace, bool completed)
+{
+    if (workspace.inventory == nullptr)
+    {
+        return;
+    }
+
+    if (!completed)
+    {
+        workspace.inventory->rollback();
+        return;
+    }
+    for (const auto& piece : workspace.left_over_pieces)
+    {
+        workspace.inventory->put(piece.dimensions_);
+    }
+    workspace.inventory->commit();
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::has_next_plank(
+    const FlooringConfig& config,
+    const Workspace& workspace) -> bool
+{
+    return workspace.current_position.second < config.room_size.second;
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::place_next_plank(
+    const FlooringConfig& config,
+    Workspace& workspace) -> Plank
+{
+    return place_slice(config, workspace, calculate_slice(config, workspace));
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::place_slice(
+    const FlooringConfig& config,
+    Workspace& workspace,
+    const std::pair<Length, Length>& slice) -> Plank
+{
+    const auto& plank_size = config.plank_size;
+    const bool is_sliced_vertically = slice.first > 0;
+    const bool is_sliced_horizontally = slice.second > 0;
+
+    if (!is_sliced_horizontally && !is_sliced_vertically)
+    {
+        workspace.index++;
+        workspace.uncut_planks++;
+        Plank plank{ workspace.index, workspace.current_position, plank_size };
+        increment_position(config, workspace, plank_size);
+        return plank;
+    }
+
+    // dimensions we are looking for
+    const std::pair<Length, Length> size_lookup{ is_sliced_vertically ? slice.first : plank_size.first,
+                                                 is_sliced_horizontally ? slice.second : plank_size.second };
+
+    auto plank = find_usable_piece(workspace, is_sliced_horizontally, is_sliced_vertically, size_lookup);
+    if (!plank && workspace.inventory != nullptr)
+    {
+        plank = take_inventory_piece(workspace, is_sliced_horizontally, is_sliced_vertically, size_lookup);
+    }
+    if (!plank)
+    {
+        // make a new plank
+        workspace.index++;
+        plank.emplace(workspace.index, workspace.current_position, size_lookup);
+
+        // store the remaining part in the left overs
+        const std::pair<Length, Length> left_over_dimensions = {
+            is_sliced_vertically ? plank_size.first - size_lookup.first : plank_size.first,
+            is_sliced_horizontally ? plank_size.second - size_lookup.second : plank_size.second
+        };
+        workspace.left_over_pieces.emplace_back(
+            workspace.index, std::pair<Length, Length>{ 0, 0 }, left_over_dimensions);
+    }
+
+    cleanup_left_over_pieces(workspace);
+    increment_position(config, workspace, size_lookup);
+    return *plank;
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+void BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::reset(Workspace& workspace)
+{
+    workspace.current_position = { 0, 0 };
+    workspace.row = 0;
+    workspace.index = 0;
+    workspace.uncut_planks = 0;
+
+    workspace.previous_row_joints.clear();
+    workspace.current_row_joints.clear();
+
+    workspace.planks.clear();
+    workspace.left_over_pieces.clear();
+
+    workspace.calculated_config.reset();
+    workspace.last_row_checkpoint.reset();
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+void BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::start(const FlooringConfig& config, Workspace& workspace)
+{
+    seed(config, workspace);
+
+    // planks placed step by step are not kept, so there is nothing to resume from
+    reset(workspace);
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::row_count(const FlooringConfig& config) -> size_t
+{
+    const auto depth = config.plank_size.second;
+    return static_cast<size_t>((config.room_size.second + depth - 1) / depth);
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+void BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::report_progress(
+    const FlooringConfig& config,
+    const Workspace& workspace)
+{
+    if (workspace.progress)
+    {
+        workspace.progress(Progress{ workspace.row, row_count(config), workspace.index });
+    }
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::start_row(const FlooringConfig& config, Workspace& workspace)
+    -> bool
+{
+    // a cancelled run leaves the workspace half way, so it cannot be resumed either
+    if (workspace.cancellation != nullptr && workspace.cancellation->is_cancelled())
+    {
+        workspace.calculated_config.reset();
+        return false;
+    }
+    report_progress(config, workspace);
+    return true;
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+void BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::save_last_row_checkpoint(
+    const FlooringConfig& config,
+    Workspace& workspace)
+{
+    const auto& position = workspace.current_position;
+    if (position.first == 0 && position.second + config.plank_size.second >= config.room_size.second)
+    {
+        workspace.last_row_checkpoint = RowCheckpoint{ position,
+                                                       workspace.row,
+                                                       workspace.index,
+                                                       workspace.uncut_planks,
+                                                       workspace.planks.size(),
+                                                       workspace.left_over_pieces,
+                                                       workspace.previous_row_joints };
+    }
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+void BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::plan_rows(
+    const FlooringConfig& config,
+    std::uint64_t seed,
+    size_t first_row,
+    size_t last_row,
+    const CancellationToken* cancellation,
+    std::vector<std::vector<std::pair<Length, Length>>>& planned_rows)
+{
+    // walks the rows without matching anything, the cuts only depend on the row and the joints of the row below
+    Workspace scratch{};
+    scratch.seed = seed;
+    scratch.row = first_row;
+    scratch.current_position = { 0, static_cast<Length>(first_row) * config.plank_size.second };
+
+    while (scratch.row < last_row && has_next_plank(config, scratch))
+    {
+        if (scratch.current_position.first == 0 && cancellation != nullptr && cancellation->is_cancelled())
+        {
+            return;
+        }
+
+        auto& cuts = planned_rows[scratch.row];
+        const auto slice = calculate_slice(config, scratch);
+        cuts.push_back(slice);
+        increment_position(
+            config,
+            scratch,
+            { (slice.first > 0) ? slice.first : config.plank_size.first,
+              (slice.second > 0) ? slice.second : config.plank_size.second });
+    }
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::fill_rows(
+    const FlooringConfig& config,
+    Workspace& workspace) -> bool
+{
+    while (has_next_plank(config, workspace))
+    {
+        if (workspace.current_position.first == 0)
+        {
+            if (!start_row(config, workspace))
+            {
+                return false;
+            }
+            save_last_row_checkpoint(config, workspace);
+        }
+        workspace.planks.push_back(place_next_plank(config, workspace));
+    }
+
+    workspace.calculated_config = config;
+    report_progress(config, workspace);
+    return true;
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::resume(const FlooringConfig& config, Workspace& workspace)
+    -> bool
+{
+    // the inventory already holds the outcome of the previous run, redoing its rows would take pieces twice
+    if (workspace.inventory != nullptr)
+    {
+        return false;
+    }
+
+    // a previous run can only be resumed when nothing but the room depth changed
+    const auto& previous = workspace.calculated_config;
+    if (!previous || previous->room_size.first != config.room_size.first ||
+        previous->plank_size != config.plank_size || previous->staggered != config.staggered ||
+        previous->randomize_lengths != config.randomize_lengths ||
+        previous->min_joint_spacing != config.min_joint_spacing || (config.seed && *config.seed != workspace.seed))
+    {
+        return false;
+    }
+
+    // rows that end inside both the old and the new room come out the same, the first row past them is redone
+    const auto depth = config.plank_size.second;
+    const auto resume_y = (std::min(config.room_size.second, previous->room_size.second) / depth) * depth;
+
+    // the previous run ended exactly on a row boundary and the room got deeper, carry on from the end state
+    if (workspace.current_position.first == 0 && workspace.current_position.second == resume_y)
+    {
+        return true;
+    }
+
+    const auto& checkpoint = workspace.last_row_checkpoint;
+    if (!checkpoint || checkpoint->position.second != resume_y)
+    {
+        return false;
+    }
+
+    workspace.current_position = checkpoint->position;
+    workspace.row = checkpoint->row;
+    workspace.index = checkpoint->index;
+    workspace.uncut_planks = checkpoint->uncut_planks;
+    workspace.planks.erase(
+        begin(workspace.planks) + static_cast<std::ptrdiff_t>(checkpoint->plank_count), end(workspace.planks));
+    workspace.left_over_pieces = checkpoint->left_over_pieces;
+    workspace.previous_row_joints = checkpoint->previous_row_joints;
+    workspace.current_row_joints.clear();
+    return true;
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::summary(const FlooringConfig& config, Workspace& workspace)
+    -> Result
+{
+    return { workspace.index,
+             static_cast<int>(workspace.left_over_pieces.size()),
+             workspace.uncut_planks,
+             {},
+             workspace.left_over_pieces,
+             workspace.seed,
+             left_over_positions(config, workspace.left_over_pieces.size()) };
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::make_result(
+    const FlooringConfig& config,
+    Workspace& workspace) -> Result
+{
+    auto result = summary(config, workspace);
+    result.planks = workspace.planks;
+    return result;
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::calculate(
+    const FlooringConfig& config,
+    Workspace& workspace) -> FlooringResult
+{
+    if (const auto error = validate(config))
+    {
+        return *error;
+    }
+    return run(config, workspace);
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::run(const FlooringConfig& config, Workspace& workspace)
+    -> FlooringResult
+{
+    seed(config, workspace);
+
+    reset(workspace);
+    const auto completed = fill_rows(config, workspace);
+    close_inventory(workspace, completed);
+    if (!completed)
+    {
+        return FlooringError::cancelled;
+    }
+    return make_result(config, workspace);
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::calculate(
+    const FlooringConfig& config,
+    Workspace& workspace,
+    const PlankSink& sink,
+    size_t chunk_size) -> FlooringResult
+{
+    if (const auto error = validate(config))
+    {
+        return *error;
+    }
+
+    start(config, workspace);
+
+    // only the leftover pool and the joints of the previous row are kept between rows
+    std::vector<Plank> chunk;
+    chunk.reserve(chunk_size);
+    while (has_next_plank(config, workspace))
+    {
+        if (workspace.current_position.first == 0 && !start_row(config, workspace))
+        {
+            close_inventory(workspace, false);
+            return FlooringError::cancelled;
+        }
+        chunk.push_back(place_next_plank(config, workspace));
+        if (chunk.size() >= chunk_size)
+        {
+            sink(chunk);
+            chunk.clear();
+        }
+    }
+    if (!chunk.empty())
+    {
+        sink(chunk);
+    }
+
+    close_inventory(workspace, true);
+    report_progress(config, workspace);
+    return summary(config, workspace);
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::calculate_parallel(
+    const FlooringConfig& config,
+    Workspace& workspace,
+    unsigned thread_count) -> FlooringResult
+{
+    if (const auto error = validate(config))
+    {
+        return *error;
+    }
+    seed(config, workspace);
+    reset(workspace);
+
+    const auto rows = row_count(config);
+    auto& planned_rows = workspace.planned_rows;
+    planned_rows.resize(rows);
+    for (auto& cuts : planned_rows)
+    {
+        cuts.clear();
+    }
+
+    // phase one, the calling thread cuts the first block of rows and the other threads the rest
+    if (thread_count == 0)
+    {
+        thread_count = std::max(1U, std::thread::hardware_concurrency());
+    }
+    if (LengthPolicy::randomized && config.min_joint_spacing > 0)
+    {
+        thread_count = 1;
+    }
+    const auto threads = std::min<size_t>(thread_count, rows);
+    const auto rows_per_thread = (rows + threads - 1) / threads;
+
+    std::vector<std::future<void>> tasks;
+    for (auto first_row = rows_per_thread; first_row < rows; first_row += rows_per_thread)
+    {
+        tasks.push_back(std::async(std::launch::async, [&, first_row]() {
+            const auto last_row = std::min(rows, first_row + rows_per_thread);
+            plan_rows(config, workspace.seed, first_row, last_row, workspace.cancellation, planned_rows);
+        }));
+    }
+    plan_rows(
+        config, workspace.seed, 0, std::min(rows, rows_per_thread), workspace.cancellation, planned_rows);
+    for (auto& task : tasks)
+    {
+        task.get();
+    }
+
+    // phase two, the leftover pool is shared by all rows so the matching runs in order
+    for (const auto& cuts : planned_rows)
+    {
+        if (!start_row(config, workspace))
+        {
+            close_inventory(workspace, false);
+            return FlooringError::cancelled;
+        }
+        save_last_row_checkpoint(config, workspace);
+        for (const auto& slice : cuts)
+        {
+            workspace.planks.push_back(place_slice(config, workspace, slice));
+        }
+    }
+
+    workspace.calculated_config = config;
+    close_inventory(workspace, true);
+    report_progress(config, workspace);
+    return make_result(config, workspace);
+}
+
+template <class StaggerPolicy, class LengthPolicy, class MatchPolicy>
+auto BasicFlooring<StaggerPolicy, LengthPolicy, MatchPolicy>::recalculate(
+    const FlooringConfig& config,
+    Workspace& workspace) -> FlooringResult
+{
+    if (const auto error = validate(config))
+    {
+        return *error;
+    }
+    if (!resume(config, workspace))
+    {
+        if (!workspace.calculated_config)
+        {
+            return run(config, workspace);
+        }
+
+        // the new layout keeps the seed of the old one unless the configuration brings its own, and is cut from new
+        // planks only since this job is already in the inventory
+        auto seeded = config;
+        if (!seeded.seed)
+        {
+            seeded.seed = workspace.seed;
+        }
+        auto* const inventory = std::exchange(workspace.inventory, nullptr);
+        auto result = run(seeded, workspace);
+        workspace.inventory = inventory;
+        return result;
+    }
+
+    if (!fill_rows(config, workspace))
+    {
+        return FlooringError::cancelled;
+    }
+    return make_result(config, workspace);
+}
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef CLI_H
+#define CLI_H
+
+// runs the calculation without opening a window and prints the results, returns the process exit code
+[[nodiscard]] auto run_cli(int argc, char* argv[]) -> int;
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef COMPACT_RESULT_H
+#define COMPACT_RESULT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "flooring.h"
+#include "plank.h"
+#include "units.h"
+
+struct RowPiece
+{
+    PlankCoordinate x;
+    PlankCoordinate width;
+    PlankCoordinate height;
+    bool from_left_over;
+
+    friend auto operator<(const RowPiece& lhs, const RowPiece& rhs) -> bool
+    {
+        return std::tie(lhs.x, lhs.width, lhs.height, lhs.from_left_over) <
+               std::tie(rhs.x, rhs.width, rhs.height, rhs.from_left_over);
+    }
+};
+
+// a row shape, stored once no matter how many rows share it
+struct RowTemplate
+{
+    std::vector<RowPiece> pieces;
+};
+
+// one row of the floor: new pieces get consecutive ids from first_new_id,
+// pieces cut from left overs take their ids from left_over_ids_ starting at left_over_begin
+struct RowInstance
+{
+    Length y;
+    size_t template_id;
+    int first_new_id;
+    size_t left_over_begin;
+};
+
+// Flyweight form of a Result for large floors: staggered layouts repeat a few row shapes many times.
+class CompactResult
+{
+public:
+    explicit CompactResult(const Result& result);
+
+    [[nodiscard]] auto row_count() const -> size_t
+    {
+        return rows_.size();
+    }
+    [[nodiscard]] auto template_count() const -> size_t
+    {
+        return templates_.size();
+    }
+
+    [[nodiscard]] auto expand_row(size_t row) const -> std::vector<Plank>;
+    [[nodiscard]] auto expand() const -> Result;
+
+    // visits the planks row by row without expanding the whole floor
+    template <class Visitor>
+    void for_each_plank(Visitor&& visit) const
+    {
+        for (const auto& row : rows_)
+        {
+            visit_row(row, visit);
+        }
+    }
+
+private:
+    int all_planks_;
+    int left_over_;
+    int uncut_;
+
+    std::vector<RowTemplate> templates_{};
+    std::vector<RowInstance> rows_{};
+    std::vector<int> left_over_ids_{};
+
+    std::vector<Plank> left_over_pieces_{};
+    std::uint64_t seed_;
+    std::vector<std::pair<Length, Length>> left_over_positions_{};
+
+    template <class Visitor>
+    void visit_row(const RowInstance& row, Visitor&& visit) const
+    {
+        auto new_id = row.first_new_id;
+        auto left_over = row.left_over_begin;
+        for (const auto& piece : templates_[row.template_id].pieces)
+        {
+            const auto id = piece.from_left_over ? left_over_ids_[left_over++] : new_id++;
+            visit(Plank{ id, { piece.x, row.y }, { piece.width, piece.height } });
+        }
+    }
+};
+
+#endif
@@ -12,10 +12,19 @@ inline constexpr float CAMERA_ZOOM_MIN = 0.1f;
 inline constexpr float CAMERA_ZOOM_MAX = 3.0f;
 inline constexpr int CAMERA_MOVE_SPEED = 8;
 
+// planks are drawn in millimetres, the camera scales them to 4 pixels per centimetre at zoom 1
+inline constexpr float DRAW_PIXELS_PER_MILLIMETRE = 0.4f;
+
 // UI SPECIFIC CONFIGURATION
+// sizes are in centimetres
 
 inline constexpr std::pair<int, int> DEFAULT_ROOM_SIZE{ 560, 400 };
 inline constexpr std::pair<int, int> DEFAULT_PLANK_SIZE{ 130, 25 };
+// random lengths only keep their seams apart from the row below when asked to, 0 leaves the joints where they fall
+inline constexpr int DEFAULT_MIN_JOINT_SPACING = 0;
+
+// pieces shorter than this count as short pieces in the layout metrics
+inline constexpr int SHORT_PIECE_LENGTH = 30;
 
 // config sliders
 inline constexpr std::pair<int, int> SLIDER_ROOM_RANGE{ 200, 801 };
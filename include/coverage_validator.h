@@ -0,0 +1,44 @@
+#ifndef COVERAGE_VALIDATOR_H
+#define COVERAGE_VALIDATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "plank.h"
+#include "units.h"
+
+struct CoverageReport
+{
+    // side of a raster cell, the greatest common divisor of the room and every plank edge
+    Length cell_size = 0;
+    std::int64_t gap_cells = 0;
+    std::int64_t overlap_cells = 0;
+    int planks_outside_room = 0;
+
+    [[nodiscard]] auto covers_exactly_once() const -> bool
+    {
+        return gap_cells == 0 && overlap_cells == 0 && planks_outside_room == 0;
+    }
+};
+
+// Checks that planks cover the room exactly once by rasterising them into a coverage and an overlap bitplane,
+// 64 cells per word, and counting the words with popcount. Large floors are swept in bands of cell rows so the
+// bitplanes stay small.
+class CoverageValidator
+{
+public:
+    // keeps its bitplanes between calls so checking every calculation does not allocate
+    [[nodiscard]] auto check(const std::pair<Length, Length>& room_size, const std::vector<Plank>& planks)
+        -> CoverageReport;
+
+private:
+    std::vector<std::uint64_t> covered_{};
+    std::vector<std::uint64_t> overlap_{};
+    std::vector<size_t> order_{};
+
+    void mark(size_t row_word, size_t first_cell, size_t end_cell);
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef EXPECTED_H
+#define EXPECTED_H
+
+#include <utility>
+#include <variant>
+
+// Either a value or the error that prevented it, for failures that are part of normal use and should not unwind
+// the stack. Dereferencing is unchecked, test has_value() first.
+template <class T, class E>
+class Expected
+{
+public:
+    Expected(T value) : storage_(std::in_place_index<0>, std::move(value)) {} // NOLINT(google-explicit-constructor)
+    Expected(E error) : storage_(std::in_place_index<1>, std::move(error)) {} // NOLINT(google-explicit-constructor)
+
+    [[nodiscard]] auto has_value() const -> bool
+    {
+        return storage_.index() == 0;
+    }
+    explicit operator bool() const
+    {
+        return has_value();
+    }
+
+    [[nodiscard]] auto operator*() -> T&
+    {
+        return *std::get_if<0>(&storage_);
+    }
+    [[nodiscard]] auto operator*() const -> const T&
+    {
+        return *std::get_if<0>(&storage_);
+    }
+    auto operator->() -> T*
+    {
+        return std::get_if<0>(&storage_);
+    }
+    auto operator->() const -> const T*
+    {
+        return std::get_if<0>(&storage_);
+    }
+
+    [[nodiscard]] auto error() const -> const E&
+    {
+        return *std::get_if<1>(&storage_);
+    }
+
+private:
+    std::variant<T, E> storage_;
+};
+
+#endif
@@ -1,71 +1,77 @@
 #ifndef FLOORING_H
 #define FLOORING_H
 
-#include <algorithm>
-#include <array>
-#include <cmath>
-#include <stdexcept>
-#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <utility>
-#include <vector>
 
+#include "basic_flooring.h"
+#include "flooring_policies.h"
 #include "plank.h"
-#include "raylib.h"
-
-inline constexpr size_t STAGGER_PATTERN_SIZE = 6;
-inline constexpr std::array<int, STAGGER_PATTERN_SIZE> STAGGER_PATTERN{ { 0, 50, -30, 30, -20, 20 } };
-
-struct Result
-{
-    int all_planks;
-    int left_over;
-    int uncut;
-    std::vector<Plank> planks;
-    std::vector<Plank> left_over_pieces;
-};
+#include "units.h"
 
+// Runtime facade over the BasicFlooring specialisations, the stagger and length switches of the configuration
+// pick one for every call.
 class Flooring
 {
 public:
+    // the calls below draw a new seed for every run unless a seed is given, with it they replay the same layout
     void configure(
-        const std::pair<int, int>& room_size,
-        const std::pair<int, int>& plank_size,
+        const std::pair<Length, Length>& room_size,
+        const std::pair<Length, Length>& plank_size,
         bool staggered,
-        bool randomize_lengths)
-    {
-        room_size_ = room_size;
-        plank_size_ = plank_size;
-        staggered_ = staggered;
-        randomize_lengths_ = randomize_lengths;
-    }
+        bool randomize_lengths,
+        Length min_joint_spacing = 0,
+        std::optional<std::uint64_t> seed = std::nullopt);
+    void configure(const FlooringConfig& config);
 
-    [[nodiscard]] auto calculate() -> Result;
+    [[nodiscard]] auto config() const -> const FlooringConfig&;
 
-private:
-    std::pair<int, int> room_size_{ 0, 0 };
-    std::pair<int, int> plank_size_{ 0, 0 };
-    bool staggered_ = false;
-    bool randomize_lengths_ = false;
+    [[nodiscard]] static auto validate(const FlooringConfig& config) -> std::optional<FlooringError>;
 
-    std::pair<int, int> current_position_{ 0, 0 };
-    size_t stagger_pattern_index_ = 0;
+    // single threaded calls, they run in the workspace owned by this object
 
-    std::vector<Plank> planks_{};
-    std::vector<Plank> left_over_pieces_{};
+    [[nodiscard]] auto calculate() -> FlooringResult;
 
-    [[nodiscard]] auto generate_color() -> Color;
-    [[nodiscard]] auto generate_lengths(int start, int end) -> int;
-    [[nodiscard]] auto calculate_slice() -> std::pair<int, int>;
+    // streams the planks to the sink instead of keeping them, the returned result has no planks
+    [[nodiscard]] auto calculate(const PlankSink& sink, size_t chunk_size = DEFAULT_CHUNK_SIZE) -> FlooringResult;
 
-    void increment_position(const std::pair<int, int>& offset);
+    // same result as calculate(), the cuts of the rows are worked out on up to thread_count threads, 0 uses all cores
+    [[nodiscard]] auto calculate_parallel(unsigned thread_count = 0) -> FlooringResult;
 
-    void cleanup_left_over_pieces();
-    void position_left_over_pieces();
+    // reuses the rows of the previous run that are not affected by a change of the room depth,
+    // falls back to a full calculation with the same seed for any other change
+    [[nodiscard]] auto recalculate() -> FlooringResult;
 
-    [[nodiscard]] auto find_and_place_usable_piece(
-        bool is_sliced_horizontally,
-        bool is_sliced_vertically,
-        const std::pair<int, int>& size_lookup) -> bool;
+    // re-entrant calls, all they change is the given workspace, so threads only need one workspace each
+
+    [[nodiscard]] static auto calculate(const FlooringConfig& config, Workspace& workspace) -> FlooringResult;
+    [[nodiscard]] static auto calculate(
+        const FlooringConfig& config,
+        Workspace& workspace,
+        const PlankSink& sink,
+        size_t chunk_size = DEFAULT_CHUNK_SIZE) -> FlooringResult;
+    [[nodiscard]] static auto calculate_parallel(
+        const FlooringConfig& config,
+        Workspace& workspace,
+        unsigned thread_count = 0) -> FlooringResult;
+    [[nodiscard]] static auto recalculate(const FlooringConfig& config, Workspace& workspace) -> FlooringResult;
+
+    // step by step calculation: start(), then place_next_plank() while has_next_plank(), then summary(),
+    // the configuration has to pass validate()
+    static void start(const FlooringConfig& config, Workspace& workspace);
+    [[nodiscard]] static auto has_next_plank(const FlooringConfig& config, const Workspace& workspace) -> bool;
+    [[nodiscard]] static auto place_next_plank(const FlooringConfig& config, Workspace& workspace) -> Plank;
+    [[nodiscard]] static auto summary(const FlooringConfig& config, Workspace& workspace) -> Result;
+
+    // planks a run opens, placed step by step without keeping any; for sampling many configurations,
+    // the configuration has to pass validate()
+    [[nodiscard]] static auto count_planks(const FlooringConfig& config, Workspace& workspace) -> int;
+
+private:
+    FlooringConfig config_{};
+    Workspace workspace_{};
 };
 
 #endif
@@ -0,0 +1,81 @@
+#ifndef FLOORING_POLICIES_H
+#define FLOORING_POLICIES_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "plank.h"
+#include "random_generator.h"
+#include "units.h"
+
+inline constexpr size_t STAGGER_PATTERN_SIZE = 6;
+inline constexpr std::array<Length, STAGGER_PATTERN_SIZE> STAGGER_PATTERN{ { 0, 500, -300, 300, -200, 200 } };
+
+// Stagger policies give the length of the first piece of a row, 0 starts the row with a full plank.
+// The row starts repeat every period rows.
+
+struct PatternStagger
+{
+    static constexpr bool staggered = true;
+    static constexpr size_t period = STAGGER_PATTERN_SIZE;
+
+    [[nodiscard]] static constexpr auto row_start(size_t row, Length plank_length) -> Length
+    {
+        const auto stagger_value = STAGGER_PATTERN[row % STAGGER_PATTERN_SIZE];
+        return (stagger_value < 0) ? plank_length + stagger_value : stagger_value;
+    }
+};
+
+struct NoStagger
+{
+    static constexpr bool staggered = false;
+    static constexpr size_t period = 1;
+
+    [[nodiscard]] static constexpr auto row_start(size_t /*row*/, Length /*plank_length*/) -> Length
+    {
+        return 0;
+    }
+};
+
+// Length policies decide how long the planks in the middle of a row are.
+
+struct FullLengths
+{
+    static constexpr bool randomized = false;
+    static constexpr Length min_length = 0;
+
+    template <class Random>
+    [[nodiscard]] static auto draw(Random& /*random*/, Length plank_length) -> Length
+    {
+        return plank_length;
+    }
+};
+
+struct RandomLengths
+{
+    static constexpr bool randomized = true;
+    static constexpr Length min_length = 400;
+
+    template <class Random>
+    [[nodiscard]] static auto draw(Random& random, Length plank_length) -> Length
+    {
+        return random.pick(min_length, plank_length);
+    }
+};
+
+// Match policies pick the left over piece a cut is taken from, returning last when none fits.
+
+struct FirstFitMatch
+{
+    template <class Iterator>
+    [[nodiscard]] static auto find(Iterator first, Iterator last, const std::pair<Length, Length>& size) -> Iterator
+    {
+        return std::find_if(first, last, [&](const Plank& p) {
+            return p.dimensions_.first >= size.first && p.dimensions_.second >= size.second;
+        });
+    }
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef LAYOUT_DISTRIBUTION_H
+#define LAYOUT_DISTRIBUTION_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "expected.h"
+#include "flooring.h"
+
+inline constexpr std::array<int, 5> DISTRIBUTION_PERCENTILES{ 5, 25, 50, 75, 95 };
+
+struct SampleSummary
+{
+    double mean = 0.0;
+    double standard_deviation = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    // nearest rank values at DISTRIBUTION_PERCENTILES
+    std::array<double, DISTRIBUTION_PERCENTILES.size()> percentiles{};
+    // runs per bin, the bins split [min, max] in equal parts
+    std::vector<int> histogram{};
+    double bin_width = 0.0;
+};
+
+struct DistributionOptions
+{
+    int runs = 1000;
+    // run i uses seed first_seed + i, so a report can be repeated and any run replayed on its own
+    std::uint64_t first_seed = 1;
+    // 0 uses all cores, the report does not depend on it
+    unsigned thread_count = 0;
+    int bins = 10;
+};
+
+struct LayoutDistribution
+{
+    int runs = 0;
+    SampleSummary planks{};
+    // share of the bought plank area that does not end up on the floor, in percent
+    SampleSummary waste_percent{};
+};
+
+// Runs the configuration with many seeds to show how much a random layout can vary, rather than one sample of it.
+// Only the counts of every run are kept, the runs are spread over threads with a workspace each.
+[[nodiscard]] auto sample_layouts(const FlooringConfig& config, const DistributionOptions& options)
+    -> Expected<LayoutDistribution, FlooringError>;
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef LAYOUT_METRICS_H
+#define LAYOUT_METRICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "flooring.h"
+#include "units.h"
+
+struct LayoutMetrics
+{
+    Length min_joint_offset = 0;
+    double average_joint_offset = 0.0;
+    int measured_joints = 0;
+    // joints closer than the minimum joint spacing to a joint of the row below, where a random length could not
+    // clear them; always 0 without a spacing
+    int close_joints = 0;
+    int short_pieces = 0;
+    int repeated_rows = 0;
+};
+
+// share of the plank area bought for the room that does not end up on the floor, in percent
+[[nodiscard]] auto waste_percent(const FlooringConfig& config, int planks) -> double;
+
+class LayoutMetricsCalculator
+{
+public:
+    explicit LayoutMetricsCalculator(Length short_piece_length, Length min_joint_spacing = 0)
+        : short_piece_length_(short_piece_length),
+          min_joint_spacing_(min_joint_spacing){};
+
+    // keeps its scratch buffers between calls so scoring many layouts does not allocate
+    [[nodiscard]] auto compute(const Result& result) -> LayoutMetrics;
+
+private:
+    Length short_piece_length_;
+    Length min_joint_spacing_;
+
+    // joints of every row in one array, row r owns joints_[row_begin_[r], row_begin_[r + 1])
+    std::vector<Length> joints_{};
+    std::vector<size_t> row_begin_{};
+    // plank widths, and for every joint above the first row the joints of the row below on either side of it,
+    // all flat so the scoring loops run over whole arrays without a branch
+    std::vector<Length> widths_{};
+    std::vector<Length> measured_{};
+    std::vector<Length> left_{};
+    std::vector<Length> right_{};
+    std::unordered_multimap<std::uint64_t, size_t> row_hashes_{};
+
+    void collect_joints(const std::vector<Plank>& planks);
+    void pair_joints();
+    void measure_joint_offsets(LayoutMetrics& metrics) const;
+    void count_repeated_rows(LayoutMetrics& metrics);
+};
+
+#endif
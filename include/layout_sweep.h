@@ -0,0 +1,83 @@
+#ifndef LAYOUT_SWEEP_H
+#define LAYOUT_SWEEP_H
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "flooring.h"
+#include "units.h"
+
+enum class SweepAxis
+{
+    room_width,
+    room_depth,
+    plank_length,
+    plank_depth
+};
+
+enum class SweepMetric
+{
+    planks,
+    waste_percent
+};
+
+[[nodiscard]] auto parse_sweep_axis(const std::string& name) -> std::optional<SweepAxis>;
+[[nodiscard]] auto sweep_axis_name(SweepAxis axis) -> const char*;
+
+struct SweepRange
+{
+    SweepAxis axis;
+    Length first;
+    Length last;
+    Length step;
+
+    [[nodiscard]] auto size() const -> size_t
+    {
+        return (step > 0 && last >= first) ? static_cast<size_t>((last - first) / step + 1) : 0;
+    }
+    [[nodiscard]] auto value(size_t i) const -> Length
+    {
+        return first + static_cast<Length>(i) * step;
+    }
+};
+
+// slider range of the axis in config.h, one centimetre apart
+[[nodiscard]] auto slider_sweep_range(SweepAxis axis) -> SweepRange;
+
+// Counts for every combination of a column and a row value, the other sizes come from the base configuration.
+// Cells are stored row by row; cells the engine rejects have planks == -1 and a NaN waste.
+struct SweepGrid
+{
+    SweepRange columns;
+    SweepRange rows;
+    std::vector<int> planks{};
+    // share of the bought plank area that does not end up on the floor
+    std::vector<float> waste_percent{};
+
+    [[nodiscard]] auto value(SweepMetric metric, size_t cell) const -> double;
+};
+
+// Cells are handed out in small chunks from a shared counter, so threads that get cheap cells take more of them,
+// and every thread reuses one workspace. With random lengths, a seed in the base configuration makes every cell
+// draw the same lengths; without one the cells are independent samples.
+[[nodiscard]] auto sweep_layouts(
+    const FlooringConfig& base,
+    const SweepRange& columns,
+    const SweepRange& rows,
+    unsigned thread_count = 0) -> SweepGrid;
+
+// header line with the column values, then one line per row starting with the row value
+void write_sweep_csv(std::ostream& out, const SweepGrid& grid, SweepMetric metric);
+
+// the magic "PLANKSWP", then axis, first, step and count of the columns and of the rows as int64, then the int32
+// plank counts and the float32 waste of all cells, all in native byte order
+void write_sweep_binary(std::ostream& out, const SweepGrid& grid);
+
+// one pixel per cell, blue for the lowest value through red for the highest, black where the engine rejects
+// the configuration; the format follows the file extension
+[[nodiscard]] auto export_sweep_heatmap(const SweepGrid& grid, SweepMetric metric, const std::string& path) -> bool;
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef LAYOUT_TABLES_H
+#define LAYOUT_TABLES_H
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include "flooring_policies.h"
+#include "units.h"
+
+struct LayoutCounts
+{
+    int all_planks = 0;
+    int left_over = 0;
+    int uncut = 0;
+    bool valid = false;
+
+    friend constexpr auto operator==(const LayoutCounts& lhs, const LayoutCounts& rhs) -> bool
+    {
+        return lhs.all_planks == rhs.all_planks && lhs.left_over == rhs.left_over && lhs.uncut == rhs.uncut &&
+               lhs.valid == rhs.valid;
+    }
+};
+
+inline constexpr size_t CONSTEXPR_POOL_CAPACITY = 128;
+
+// Counts of the deterministic engine (BasicFlooring<StaggerPolicy, FullLengths, FirstFitMatch>) that can run at
+// compile time: same placement and first fit leftover matching, with a fixed capacity pool instead of vectors.
+// Returns valid == false where the runtime engine rejects the configuration or the pool is too small.
+template <class StaggerPolicy = PatternStagger, size_t PoolCapacity = CONSTEXPR_POOL_CAPACITY>
+[[nodiscard]] constexpr auto count_layout(
+    const std::pair<Length, Length>& room_size,
+    const std::pair<Length, Length>& plank_size) -> LayoutCounts
+{
+    // std::pair assignment is not constexpr before C++20, so everything is kept in scalars
+    std::array<Length, PoolCapacity> pool_width{};
+    std::array<Length, PoolCapacity> pool_height{};
+    size_t pool_size = 0;
+
+    LayoutCounts counts{};
+    Length x = 0;
+    Length y = 0;
+    size_t row = 0;
+
+    while (y < room_size.second)
+    {
+        Length slice_width = 0;
+        Length slice_height = 0;
+        if (StaggerPolicy::staggered && x == 0)
+        {
+            slice_width = StaggerPolicy::row_start(row, plank_size.first);
+            if (slice_width < 0 || slice_width >= plank_size.first)
+            {
+                return counts;
+            }
+            if (slice_width == 0 && plank_size.first > room_size.first)
+            {
+                slice_width = room_size.first;
+            }
+        }
+        else if (x + plank_size.first > room_size.first)
+        {
+            slice_width = room_size.first - x;
+        }
+        if (x + slice_width > room_size.first)
+        {
+            return counts;
+        }
+        if (y + plank_size.second > room_size.second)
+        {
+            slice_height = room_size.second - y;
+        }
+
+        const auto width = (slice_width > 0) ? slice_width : plank_size.first;
+        const auto height = (slice_height > 0) ? slice_height : plank_size.second;
+        if (slice_width == 0 && slice_height == 0)
+        {
+            counts.all_planks++;
+            counts.uncut++;
+        }
+        else
+        {
+            // first fit, like FirstFitMatch
+            size_t piece = 0;
+            while (piece < pool_size && !(pool_width[piece] >= width && pool_height[piece] >= height))
+            {
+                piece++;
+            }
+
+            if (piece < pool_size)
+            {
+                pool_height[piece] -= (slice_height > 0) ? height : 0;
+                pool_width[piece] -= (slice_width > 0) ? width : 0;
+
+                // drop the piece once it is used up, keeping the order first fit depends on
+                if (pool_width[piece] <= 0 || pool_height[piece] <= 0)
+                {
+                    for (size_t i = piece + 1; i < pool_size; i++)
+                    {
+                        pool_width[i - 1] = pool_width[i];
+                        pool_height[i - 1] = pool_height[i];
+                    }
+                    pool_size--;
+                }
+            }
+            else
+            {
+                counts.all_planks++;
+
+                const auto left_over_width = (slice_width > 0) ? plank_size.first - width : plank_size.first;
+                const auto left_over_height = (slice_height > 0) ? plank_size.second - height : plank_size.second;
+                if (left_over_width > 0 && left_over_height > 0)
+                {
+                    if (pool_size == PoolCapacity)
+                    {
+                        return counts;
+                    }
+                    pool_width[pool_size] = left_over_width;
+                    pool_height[pool_size] = left_over_height;
+                    pool_size++;
+                }
+            }
+        }
+
+        x += width;
+        if (x >= room_size.first)
+        {
+            x = 0;
+            y += height;
+            row++;
+        }
+    }
+
+    counts.left_over = static_cast<int>(pool_size);
+    counts.valid = true;
+    return counts;
+}
+
+// Table lookup for staggered layouts where at most one of the four slider values (in centimetres, see config.h)
+// differs from the defaults, empty for anything the tables do not cover.
+[[nodiscard]] auto lookup_layout_counts(const std::pair<int, int>& room_size, const std::pair<int, int>& plank_size)
+    -> std::optional<LayoutCounts>;
+
+#endif
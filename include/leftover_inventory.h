@@ -0,0 +1,69 @@
+#ifndef LEFTOVER_INVENTORY_H
+#define LEFTOVER_INVENTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "units.h"
+
+struct InventoryPiece
+{
+    // unique within the inventory file, pieces taken from it are placed with id -serial
+    std::uint64_t serial;
+    std::pair<Length, Length> dimensions;
+};
+
+// Offcuts kept between jobs, stored in a memory-mapped file so tens of thousands of pieces load without parsing.
+// Every record carries a checksum and is written on its own, so a crash can lose part of the last commit but never
+// leaves a half written piece behind: on open, records that do not check out are treated as free slots.
+// Pieces taken by a calculation are only reserved until commit() writes the change or rollback() returns them.
+class LeftoverInventory
+{
+public:
+    // opens the inventory, creating the file when it does not exist; throws std::runtime_error on failure
+    explicit LeftoverInventory(const std::string& path);
+    ~LeftoverInventory();
+
+    LeftoverInventory(const LeftoverInventory&) = delete;
+    auto operator=(const LeftoverInventory&) -> LeftoverInventory& = delete;
+
+    // pieces available to take
+    [[nodiscard]] auto size() const -> size_t;
+    [[nodiscard]] auto pieces() const -> std::vector<InventoryPiece>;
+
+    // smallest piece by area that is at least as large as size in both directions
+    [[nodiscard]] auto take(const std::pair<Length, Length>& size) -> std::optional<InventoryPiece>;
+    void put(const std::pair<Length, Length>& dimensions);
+
+    // writes the taken pieces out first and the new ones second, so a crash in between loses pieces rather than
+    // offering ones that were already used; throws std::runtime_error when the file cannot grow
+    void commit();
+    void rollback();
+
+private:
+    struct MappedFile;
+
+    std::unique_ptr<MappedFile> file_;
+
+    // height -> width -> record slot, a lookup visits the heights that fit and one width in each
+    std::map<Length, std::multimap<Length, size_t>> index_{};
+    size_t size_ = 0;
+
+    std::vector<size_t> free_slots_{};
+    std::uint64_t next_serial_ = 1;
+
+    std::vector<size_t> pending_takes_{};
+    std::vector<std::pair<Length, Length>> pending_puts_{};
+
+    void load();
+    void add_to_index(size_t slot);
+    [[nodiscard]] auto acquire_slot() -> size_t;
+};
+
+#endif
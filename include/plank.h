@@ -1,41 +1,89 @@
 #ifndef PLANK_H
 #define PLANK_H
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <sstream>
 #include <string>
 #include <utility>
 
+#include "config.h"
+#include "random_generator.h"
 #include "raylib.h"
+#include "units.h"
+
+// planks are drawn in one of 64 colours with channels from 100 to 255, the entry after them is for the pieces taken
+// from the leftover inventory, which are placed with ids below 1
+inline constexpr std::size_t PLANK_COLOR_BITS = 6;
+inline constexpr std::size_t INVENTORY_COLOR_INDEX = std::size_t{ 1 } << PLANK_COLOR_BITS;
+
+inline constexpr auto PLANK_PALETTE = [] {
+    std::array<Color, INVENTORY_COLOR_INDEX + 1> palette{};
+    std::uint64_t state = 0;
+    for (std::size_t i = 0; i < INVENTORY_COLOR_INDEX; i++)
+    {
+        const auto bits = splitmix64(state);
+        palette[i] = { static_cast<unsigned char>(100 + (bits & 0xffffU) % 156),
+                       static_cast<unsigned char>(100 + ((bits >> 16U) & 0xffffU) % 156),
+                       static_cast<unsigned char>(100 + ((bits >> 32U) & 0xffffU) % 156),
+                       255 };
+    }
+    palette[INVENTORY_COLOR_INDEX] = { 190, 190, 190, 255 };
+    return palette;
+}();
+
+// Fibonacci hashing spreads consecutive ids over the palette, so a plank, the pieces cut from it and the same plank
+// in every later calculation share a colour that costs no random draw
+[[nodiscard]] constexpr auto plank_color_index(int id) -> std::uint8_t
+{
+    if (id < 1)
+    {
+        return static_cast<std::uint8_t>(INVENTORY_COLOR_INDEX);
+    }
+    return static_cast<std::uint8_t>((static_cast<std::uint32_t>(id) * 0x9E3779B9U) >> (32U - PLANK_COLOR_BITS));
+}
 
 struct Plank
 {
     int id_;
-    std::pair<int, int> position_;
-    std::pair<int, int> dimensions_;
-    Color color_;
+    std::pair<PlankCoordinate, PlankCoordinate> position_;
+    std::pair<PlankCoordinate, PlankCoordinate> dimensions_;
+    std::uint8_t color_index_;
 
-    explicit Plank(int identifier, std::pair<int, int> position, std::pair<int, int> dimensions, Color color)
+    explicit Plank(int identifier, const std::pair<Length, Length>& position, const std::pair<Length, Length>& dimensions)
         : id_(identifier),
-          position_(std::move(position)),
-          dimensions_(std::move(dimensions)),
-          color_(color){};
+          position_(to_plank_coordinates(position)),
+          dimensions_(to_plank_coordinates(dimensions)),
+          color_index_(plank_color_index(identifier)){};
+
+    [[nodiscard]] auto color() const -> Color
+    {
+        return PLANK_PALETTE[color_index_];
+    }
 
-    auto draw() const -> void
+    // draws in millimetres moved by offset, the camera zoom scales the floor to the screen
+    auto draw(const std::pair<Length, Length>& offset = { 0, 0 }) const -> void
     {
-        static constexpr auto fontSize = 24;
-        static constexpr auto drawScaleFactor = 4;
-        static constexpr auto textOffset = 6;
+        static constexpr auto fontSize = static_cast<int>(24 / DRAW_PIXELS_PER_MILLIMETRE);
+        static constexpr auto textOffset = 6 / DRAW_PIXELS_PER_MILLIMETRE;
+        static constexpr auto lineThickness = 1 / DRAW_PIXELS_PER_MILLIMETRE;
 
-        const auto x = position_.first * drawScaleFactor;
-        const auto y = position_.second * drawScaleFactor;
-        const auto w = dimensions_.first * drawScaleFactor;
-        const auto h = dimensions_.second * drawScaleFactor;
+        const Rectangle rect{ static_cast<float>(offset.first + position_.first),
+                              static_cast<float>(offset.second + position_.second),
+                              static_cast<float>(dimensions_.first),
+                              static_cast<float>(dimensions_.second) };
 
-        DrawRectangle(x, y, w, h, color_);
+        DrawRectangleRec(rect, color());
         std::stringstream ss;
         ss << '(' << id_ << ") " << dimensions_.first << " x " << dimensions_.second;
-        DrawText(ss.str().c_str(), x + textOffset, y + textOffset, fontSize, DARKGRAY);
-        DrawRectangleLines(x, y, w, h, BLACK);
+        DrawText(
+            ss.str().c_str(),
+            static_cast<int>(rect.x + textOffset),
+            static_cast<int>(rect.y + textOffset),
+            fontSize,
+            DARKGRAY);
+        DrawRectangleLinesEx(rect, lineThickness, BLACK);
     }
 };
 
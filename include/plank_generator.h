@@ -0,0 +1,86 @@
+#ifndef PLANK_GENERATOR_H
+#define PLANK_GENERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+
+#include "flooring.h"
+#include "plank.h"
+
+// Lazy counterpart of Flooring::calculate(): places the planks one at a time in row order and keeps only the
+// state needed for the next plank, so consumers can start straight away and run in constant memory.
+class PlankGenerator
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Plank;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Plank*;
+        using reference = const Plank&;
+
+        iterator() = default;
+        explicit iterator(PlankGenerator* generator) : generator_(generator){};
+
+        auto operator*() const -> reference
+        {
+            return *generator_->current_;
+        }
+        auto operator->() const -> pointer
+        {
+            return &*generator_->current_;
+        }
+        auto operator++() -> iterator&
+        {
+            generator_->advance();
+            return *this;
+        }
+        void operator++(int)
+        {
+            generator_->advance();
+        }
+
+        friend auto operator==(const iterator& lhs, const iterator& rhs) -> bool
+        {
+            return lhs.done() == rhs.done();
+        }
+        friend auto operator!=(const iterator& lhs, const iterator& rhs) -> bool
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        PlankGenerator* generator_ = nullptr;
+
+        [[nodiscard]] auto done() const -> bool
+        {
+            return generator_ == nullptr || !generator_->current_;
+        }
+    };
+
+    // takes the configuration of the given engine, its last results are not copied
+    explicit PlankGenerator(const Flooring& flooring);
+
+    [[nodiscard]] auto begin() -> iterator;
+    [[nodiscard]] auto end() -> iterator;
+
+    // counts and left over pieces, complete once the generator is exhausted
+    [[nodiscard]] auto summary() -> Result;
+
+    // set by begin() when the configuration is rejected, the generator is empty then
+    [[nodiscard]] auto error() const -> std::optional<FlooringError>;
+
+private:
+    FlooringConfig config_{};
+    Workspace workspace_{};
+    std::optional<Plank> current_{};
+    std::optional<FlooringError> error_{};
+    bool started_ = false;
+
+    void advance();
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef PLANK_WRITER_H
+#define PLANK_WRITER_H
+
+#include <ostream>
+#include <vector>
+
+#include "plank.h"
+
+// plank sink writing one CSV line per plank, usable with Flooring::calculate(sink)
+class CsvPlankWriter
+{
+public:
+    explicit CsvPlankWriter(std::ostream& out);
+
+    void operator()(const std::vector<Plank>& planks) const;
+
+private:
+    std::ostream* out_;
+};
+
+#endif
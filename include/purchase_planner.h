@@ -0,0 +1,83 @@
+#ifndef PURCHASE_PLANNER_H
+#define PURCHASE_PLANNER_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flooring.h"
+
+struct BoxOption
+{
+    int planks_per_box;
+    // cents
+    std::int64_t price;
+};
+
+struct Product
+{
+    std::string name;
+    std::vector<BoxOption> boxes;
+};
+
+struct PurchaseJob
+{
+    int planks_needed;
+    int waste_reserve_percent;
+};
+
+// a room of a batch run, the plank and the layout options are shared by all projects
+struct PurchaseProject
+{
+    std::string name;
+    // centimetres, like the sliders and the command line
+    std::pair<int, int> room_size;
+    int waste_reserve_percent;
+};
+
+struct Purchase
+{
+    bool feasible = false;
+    size_t product = 0;
+    int planks = 0;
+    // cents
+    std::int64_t price = 0;
+    std::vector<int> box_counts{};
+};
+
+[[nodiscard]] auto make_purchase_job(const Result& result, int waste_reserve_percent) -> PurchaseJob;
+
+// "product,planks per box,price" lines after a header line, one line per box option; the lines of a product share
+// its name. Prices have up to two decimals and are read into cents. Throws std::runtime_error on a malformed line,
+// including numbers with trailing text.
+[[nodiscard]] auto read_catalogue(std::istream& in) -> std::vector<Product>;
+
+// "project,room width,room depth,waste reserve percent" lines after a header line.
+// Throws std::runtime_error on a malformed line.
+[[nodiscard]] auto read_projects(std::istream& in) -> std::vector<PurchaseProject>;
+
+class PurchasePlanner
+{
+public:
+    // throws std::invalid_argument when a box has a negative price, the cost table relies on prices only growing
+    // with the number of boxes
+    explicit PurchasePlanner(std::vector<Product> catalogue);
+
+    [[nodiscard]] auto product(size_t index) const -> const Product&
+    {
+        return catalogue_.at(index);
+    }
+
+    // cheapest product and box combination for every job
+    [[nodiscard]] auto plan(const std::vector<PurchaseJob>& jobs) const -> std::vector<Purchase>;
+
+    // cheapest box combination of a single product for every job
+    [[nodiscard]] auto plan_product(size_t product, const std::vector<PurchaseJob>& jobs) const -> std::vector<Purchase>;
+
+private:
+    std::vector<Product> catalogue_;
+};
+
+#endif
@@ -1,25 +1,298 @@
 #ifndef RANDOM_GENERATOR_H
 #define RANDOM_GENERATOR_H
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <random>
 
-auto get_global_random() -> std::default_random_engine&
+// step of the splitmix64 sequence, spreads any 64 bit value over the whole state of an engine
+[[nodiscard]] constexpr auto splitmix64(std::uint64_t& state) -> std::uint64_t
 {
-    static std::default_random_engine u{};
-    return u;
+    auto z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27U)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31U);
 }
 
-void randomize()
+// xoshiro256**: 32 bytes of state and a handful of instructions per number, every calculation draws from its own
+// engine, so concurrent calculations never share random state
+class RandomEngine
 {
-    static std::random_device rd{};
-    get_global_random().seed(rd());
+public:
+    using result_type = std::uint64_t;
+
+    RandomEngine() : RandomEngine(0)
+    {
+    }
+    explicit RandomEngine(std::uint64_t seed)
+    {
+        this->seed(seed);
+    }
+
+    // the whole 64 bits of the seed count, seeds that differ in any bit give different draws
+    void seed(std::uint64_t seed)
+    {
+        for (auto& word : state_)
+        {
+            word = splitmix64(seed);
+        }
+    }
+
+    [[nodiscard]] static constexpr auto min() -> result_type
+    {
+        return 0;
+    }
+    [[nodiscard]] static constexpr auto max() -> result_type
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    auto operator()() -> result_type
+    {
+        const auto result = rotate_left(state_[1] * 5, 7) * 9;
+        const auto t = state_[1] << 17U;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotate_left(state_[3], 45);
+        return result;
+    }
+
+private:
+    std::array<std::uint64_t, 4> state_{};
+
+    [[nodiscard]] static constexpr auto rotate_left(std::uint64_t value, unsigned shift) -> std::uint64_t
+    {
+        return (value << shift) | (value >> (64U - shift));
+    }
+};
+
+// fresh seed for a run that was not given one
+inline auto random_seed() -> std::uint64_t
+{
+    thread_local std::random_device rd{};
+    return (static_cast<std::uint64_t>(rd()) << 32U) | rd();
+}
+
+// seed of the independent stream for one row of a layout, the same seed and row always give the same draws
+[[nodiscard]] constexpr auto row_stream_seed(std::uint64_t seed, std::size_t row) -> std::uint64_t
+{
+    auto state = static_cast<std::uint64_t>(row);
+    return seed ^ splitmix64(state);
+}
+
+// Fills out with values in [0, range) using Lemire's multiply and shift, range has to be below 2^32.
+// The engine runs first and on its own, as every draw depends on the previous state; the scaling pass has no
+// dependency between values and no branch, so it vectorises. The rare draws the scaling would bias are redrawn
+// after that, which needs a single division for the whole block.
+inline void fill_bounded(RandomEngine& engine, std::uint32_t range, std::uint32_t* out, std::size_t count)
+{
+    static constexpr auto rejected = std::numeric_limits<std::uint32_t>::max();
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        out[i] = static_cast<std::uint32_t>(engine() >> 32U);
+    }
+
+    const auto threshold = static_cast<std::uint32_t>(0U - range) % range;
+    std::uint32_t rejections = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const auto scaled = static_cast<std::uint64_t>(out[i]) * range;
+        const bool biased = static_cast<std::uint32_t>(scaled) < threshold;
+        rejections += biased ? 1U : 0U;
+        out[i] = biased ? rejected : static_cast<std::uint32_t>(scaled >> 32U);
+    }
+
+    for (std::size_t i = 0; rejections > 0 && i < count; i++)
+    {
+        if (out[i] != rejected)
+        {
+            continue;
+        }
+        auto scaled = static_cast<std::uint64_t>(engine() >> 32U) * range;
+        while (static_cast<std::uint32_t>(scaled) < threshold)
+        {
+            scaled = static_cast<std::uint64_t>(engine() >> 32U) * range;
+        }
+        out[i] = static_cast<std::uint32_t>(scaled >> 32U);
+        rejections--;
+    }
+}
+
+// Engine handing out bounded integers from a block of Capacity values drawn ahead with fill_bounded().
+// Draws with another range start a new block; ranges of 2^32 values and more are drawn one by one.
+template <std::size_t Capacity>
+class BatchedRandom
+{
+public:
+    void seed(std::uint64_t seed)
+    {
+        engine_.seed(seed);
+        position_ = Capacity;
+    }
+
+    // full 64 bit draw, straight from the engine
+    [[nodiscard]] auto next() -> std::uint64_t
+    {
+        return engine_();
+    }
+
+    [[nodiscard]] auto pick(std::int64_t from, std::int64_t thru) -> std::int64_t
+    {
+        const auto range = static_cast<std::uint64_t>(thru - from) + 1;
+        if (range == 0 || range >= std::numeric_limits<std::uint32_t>::max())
+        {
+            return from + static_cast<std::int64_t>(pick_wide(range));
+        }
+        if (position_ == Capacity || from != from_ || range != range_)
+        {
+            from_ = from;
+            range_ = static_cast<std::uint32_t>(range);
+            fill_bounded(engine_, range_, values_.data(), Capacity);
+            position_ = 0;
+        }
+        return from_ + values_[position_++];
+    }
+
+private:
+    RandomEngine engine_{};
+    std::array<std::uint32_t, Capacity> values_{};
+    std::size_t position_ = Capacity;
+    std::int64_t from_ = 0;
+    std::uint32_t range_ = 0;
+
+    // rejection on the top of the 64 bit range, 0 stands for all 2^64 values
+    [[nodiscard]] auto pick_wide(std::uint64_t range) -> std::uint64_t
+    {
+        if (range == 0)
+        {
+            return engine_();
+        }
+        const auto limit = RandomEngine::max() - RandomEngine::max() % range;
+        auto value = engine_();
+        while (value >= limit)
+        {
+            value = engine_();
+        }
+        return value % range;
+    }
+};
+
+// starts the stream of one row: the row's seed feeds a fresh engine
+template <std::size_t Capacity>
+void seed_row(BatchedRandom<Capacity>& random, std::uint64_t seed, std::size_t row)
+{
+    random.seed(row_stream_seed(seed, row));
 }
 
-auto random_pick(int from, int thru) -> int
+using PhiloxBlock = std::array<std::uint32_t, 4>;
+
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3"): ten rounds of multiplies and xors.
+// The output is a function of the counter and the key only, so every counter gives its own four words and no state
+// has to be carried from one draw to the next.
+[[nodiscard]] constexpr auto philox4x32(PhiloxBlock counter, std::uint64_t key) -> PhiloxBlock
+{
+    auto key_low = static_cast<std::uint32_t>(key);
+    auto key_high = static_cast<std::uint32_t>(key >> 32U);
+    for (int round = 0; round < 10; round++)
+    {
+        const auto first = std::uint64_t{ 0xD2511F53U } * counter[0];
+        const auto second = std::uint64_t{ 0xCD9E8D57U } * counter[2];
+        counter = { static_cast<std::uint32_t>(second >> 32U) ^ counter[1] ^ key_low,
+                    static_cast<std::uint32_t>(second),
+                    static_cast<std::uint32_t>(first >> 32U) ^ counter[3] ^ key_high,
+                    static_cast<std::uint32_t>(first) };
+        key_low += 0x9E3779B9U;
+        key_high += 0xBB67AE85U;
+    }
+    return counter;
+}
+
+// known answers of the reference implementation
+inline constexpr auto PHILOX_ZERO_ANSWER = philox4x32({ 0, 0, 0, 0 }, 0);
+static_assert(PHILOX_ZERO_ANSWER[0] == 0x6627e8d5U && PHILOX_ZERO_ANSWER[1] == 0xe169c58dU &&
+              PHILOX_ZERO_ANSWER[2] == 0xbc57ac4cU && PHILOX_ZERO_ANSWER[3] == 0x9b00dbd8U);
+inline constexpr auto PHILOX_PI_ANSWER =
+    philox4x32({ 0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U }, 0x299f31d0a4093822ULL);
+static_assert(PHILOX_PI_ANSWER[0] == 0xd16cfe09U && PHILOX_PI_ANSWER[1] == 0x94fdccebU &&
+              PHILOX_PI_ANSWER[2] == 0x5001e420U && PHILOX_PI_ANSWER[3] == 0x24126ea1U);
+
+// Counter based stream of one row: the draw for cut n of row r is philox4x32({r, n, attempt}, seed), so any cut of
+// any row can be drawn directly, without replaying the rows or the cuts before it, on whichever thread gets it.
+// A draw rejected by the bounded scaling takes the next word of its block, then the block of the next attempt.
+class CounterRandom
+{
+public:
+    void seed(std::uint64_t seed, std::size_t row)
+    {
+        seed_ = seed;
+        row_ = static_cast<std::uint64_t>(row);
+        cut_ = 0;
+    }
+
+    [[nodiscard]] auto pick(std::int64_t from, std::int64_t thru) -> std::int64_t
+    {
+        const auto range = static_cast<std::uint64_t>(thru - from) + 1;
+        const auto cut = cut_++;
+        if (range == 0 || range > std::numeric_limits<std::uint32_t>::max())
+        {
+            return from + static_cast<std::int64_t>(pick_wide(cut, range));
+        }
+
+        const auto range32 = static_cast<std::uint32_t>(range);
+        const auto threshold = static_cast<std::uint32_t>(0U - range32) % range32;
+        for (std::uint32_t attempt = 0;; attempt++)
+        {
+            for (const auto word : block(cut, attempt))
+            {
+                const auto scaled = static_cast<std::uint64_t>(word) * range32;
+                if (static_cast<std::uint32_t>(scaled) >= threshold)
+                {
+                    return from + static_cast<std::int64_t>(scaled >> 32U);
+                }
+            }
+        }
+    }
+
+private:
+    std::uint64_t seed_ = 0;
+    std::uint64_t row_ = 0;
+    std::uint32_t cut_ = 0;
+
+    [[nodiscard]] auto block(std::uint32_t cut, std::uint32_t attempt) const -> PhiloxBlock
+    {
+        return philox4x32(
+            { static_cast<std::uint32_t>(row_), static_cast<std::uint32_t>(row_ >> 32U), cut, attempt }, seed_);
+    }
+
+    // rejection on the top of the 64 bit range, 0 stands for all 2^64 values
+    [[nodiscard]] auto pick_wide(std::uint32_t cut, std::uint64_t range) const -> std::uint64_t
+    {
+        const auto max = std::numeric_limits<std::uint64_t>::max();
+        const auto limit = (range == 0) ? max : max - max % range;
+        for (std::uint32_t attempt = 0;; attempt++)
+        {
+            const auto words = block(cut, attempt);
+            for (std::size_t i = 0; i < words.size(); i += 2)
+            {
+                const auto value = (static_cast<std::uint64_t>(words[i]) << 32U) | words[i + 1];
+                if (range == 0 || value < limit)
+                {
+                    return (range == 0) ? value : value % range;
+                }
+            }
+        }
+    }
+};
+
+inline void seed_row(CounterRandom& random, std::uint64_t seed, std::size_t row)
 {
-    static std::uniform_int_distribution<> d{};
-    using parm_t = decltype(d)::param_type;
-    return d(get_global_random(), parm_t{ from, thru });
+    random.seed(seed, row);
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,43 @@
+#ifndef ROW_OFFSETS_H
+#define ROW_OFFSETS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "flooring.h"
+#include "units.h"
+
+// end of a full length row for one length of its first piece, 0 starts the row with a full plank
+struct RowOffsetScore
+{
+    Length offset;
+    // length of the last piece, 0 when the row ends on a plank joint
+    Length end_cut;
+    // rest of the plank the last piece is cut from, lost when it is shorter than the shortest useful piece
+    Length waste;
+    // the first or the last piece is shorter than the shortest useful piece
+    bool short_piece;
+};
+
+// Scores count candidate offsets at once. The end of a row only depends on (room width - offset) mod plank length,
+// which for offsets inside the plank is one subtraction and a conditional add of the plank length, so the loop has
+// no division and no branch and the compiler vectorises it. Offsets and cuts are shorter than a plank, so they are
+// 32 bit to fit twice as many in a vector register. Offsets wider than the room are scored as a short piece and
+// the waste of a whole plank. The output arrays hold count values each, short_pieces holds 0 or 1.
+void evaluate_row_offsets(
+    Length room_width,
+    std::int32_t plank_length,
+    std::int32_t min_piece,
+    const std::int32_t* offsets,
+    size_t count,
+    std::int32_t* end_cuts,
+    std::int32_t* waste,
+    std::int32_t* short_pieces);
+
+// every offset from 0 to the plank length in steps of step, best first: no short piece, then the least waste,
+// then the shortest offset
+[[nodiscard]] auto rank_row_offsets(const FlooringConfig& config, Length min_piece, Length step)
+    -> std::vector<RowOffsetScore>;
+
+#endif
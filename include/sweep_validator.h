@@ -0,0 +1,60 @@
+#ifndef SWEEP_VALIDATOR_H
+#define SWEEP_VALIDATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "basic_flooring.h"
+#include "units.h"
+
+struct LayoutReport
+{
+    // square millimetres of the room no plank covers
+    std::int64_t gap_area = 0;
+    int overlapping_planks = 0;
+    int planks_outside_room = 0;
+    // ids whose placed and left over pieces add up to more than one plank
+    std::vector<int> overused_ids{};
+
+    [[nodiscard]] auto is_exact() const -> bool
+    {
+        return gap_area == 0 && overlapping_planks == 0 && planks_outside_room == 0 && overused_ids.empty();
+    }
+};
+
+// Proves a result covers its room exactly once in O(n log n), whatever the size of the room: a line sweeps across
+// the room stopping at plank edges, keeping the rows of the planks it crosses as disjoint intervals. It takes over
+// from the raster CoverageValidator on floors too large to rasterise.
+// A plank overlapping one already on the line is counted and left out, so its area can also show up as a gap.
+// Pieces taken from the inventory (ids below 1) come from pieces of unknown size and are left out of the material
+// check.
+class SweepValidator
+{
+public:
+    // keeps its event and interval buffers between calls
+    [[nodiscard]] auto check(const FlooringConfig& config, const Result& result) -> LayoutReport;
+    // only the material part of check, for floors whose coverage is checked by another validator
+    [[nodiscard]] auto overused_ids(const FlooringConfig& config, const Result& result) -> std::vector<int>;
+
+private:
+    struct Edge
+    {
+        Length x;
+        bool opens;
+        size_t plank;
+    };
+
+    std::vector<Edge> edges_{};
+    std::vector<bool> on_line_{};
+    // top -> bottom of the planks crossing the line
+    std::map<Length, Length> line_{};
+    // area used per plank id, both on the floor and left over
+    std::vector<std::int64_t> used_area_{};
+
+    void sweep(const std::pair<Length, Length>& room_size, const std::vector<Plank>& planks, LayoutReport& report);
+};
+
+#endif
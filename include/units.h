@@ -0,0 +1,51 @@
+#ifndef UNITS_H
+#define UNITS_H
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+// Engine geometry is in millimetres and 64 bit, so warehouse sized floors do not overflow.
+// The GUI and the command line work in centimetres and convert at the edges.
+using Length = std::int64_t;
+
+inline constexpr Length MILLIMETRES_PER_CENTIMETRE = 10;
+
+// Positions and sizes stored in every plank. Builds with FLOORING_PACKED_PLANKS keep them in 16 bits, which covers
+// rooms up to 65 m and takes a plank from 48 to 16 bytes; larger rooms and planks are rejected by validation.
+#ifdef FLOORING_PACKED_PLANKS
+using PlankCoordinate = std::uint16_t;
+#else
+using PlankCoordinate = Length;
+#endif
+
+inline constexpr Length MAX_PLANK_COORDINATE = std::numeric_limits<PlankCoordinate>::max();
+
+// the one place a plank narrows its coordinates; the engine only places planks inside the validated room and keeps
+// the display positions of the left overs outside them, so a packed build never loses a coordinate
+[[nodiscard]] constexpr auto to_plank_coordinate(Length value) -> PlankCoordinate
+{
+#ifdef FLOORING_PACKED_PLANKS
+    assert(value >= 0 && value <= MAX_PLANK_COORDINATE);
+#endif
+    return static_cast<PlankCoordinate>(value);
+}
+
+[[nodiscard]] constexpr auto to_plank_coordinates(const std::pair<Length, Length>& values)
+    -> std::pair<PlankCoordinate, PlankCoordinate>
+{
+    return { to_plank_coordinate(values.first), to_plank_coordinate(values.second) };
+}
+
+[[nodiscard]] constexpr auto from_centimetres(int centimetres) -> Length
+{
+    return static_cast<Length>(centimetres) * MILLIMETRES_PER_CENTIMETRE;
+}
+
+[[nodiscard]] constexpr auto from_centimetres(const std::pair<int, int>& centimetres) -> std::pair<Length, Length>
+{
+    return { from_centimetres(centimetres.first), from_centimetres(centimetres.second) };
+}
+
+#endif
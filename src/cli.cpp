@@ -0,0 +1,431 @@
+#include "cli.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "config.h"
+#include "flooring.h"
+#include "layout_distribution.h"
+#include "layout_metrics.h"
+#include "layout_sweep.h"
+#include "layout_tables.h"
+#include "leftover_inventory.h"
+#include "plank_writer.h"
+#include "purchase_planner.h"
+#include "row_offsets.h"
+#include "units.h"
+
+namespace
+{
+    void print_usage()
+    {
+        std::cerr << "Usage: flooring_layout [--room X Y] [--plank X Y] [--spacing N] [--no-stagger] [--random]\n"
+                  << "                       [--seed N] [--threads N] [--inventory FILE] [--csv FILE] [--counts]\n"
+                  << "                       [--distribution RUNS]\n"
+                  << "                       [--sweep X_AXIS Y_AXIS] [--metric planks|waste] [--matrix FILE]\n"
+                  << "                       [--heatmap FILE] [--offsets N] [--purchase CATALOGUE PROJECTS]\n"
+                  << "Sizes are in centimetres, the results and the CSV output in millimetres.\n"
+                  << "--seed repeats the layout of an earlier run with the seed it printed.\n"
+                  << "--inventory takes offcuts from the file before cutting new planks and stores the new ones in it,\n"
+                  << "pieces from the inventory have ids below 1.\n"
+                  << "--distribution reports how the counts vary over RUNS layouts seeded from --seed on,\n"
+                  << "on --threads threads.\n"
+                  << "--sweep counts every combination of two slider ranges, the axes are room-width, room-depth,\n"
+                  << "plank-length and plank-depth; --matrix writes the grid as CSV, or binary when FILE ends in .bin,\n"
+                  << "--heatmap renders the --metric of the grid as an image.\n"
+                  << "--offsets lists the N first piece lengths, 1 cm apart, that end the rows with the least waste.\n"
+                  << "--purchase lays out every room of the PROJECTS CSV (project,width,depth,reserve percent) with\n"
+                  << "the other options and prints the cheapest boxes from the CATALOGUE CSV (product,planks,price),\n"
+                  << "prices have up to two decimals.\n";
+    }
+
+    void print_summary(const char* name, const SampleSummary& summary)
+    {
+        static constexpr auto bar_width = 40;
+
+        std::cout << name << ": mean " << summary.mean << ", standard deviation " << summary.standard_deviation
+                  << ", min " << summary.min << ", max " << summary.max << '\n';
+        for (size_t i = 0; i < DISTRIBUTION_PERCENTILES.size(); i++)
+        {
+            std::cout << "  " << DISTRIBUTION_PERCENTILES[i] << "th percentile: " << summary.percentiles[i] << '\n';
+        }
+
+        const auto most = *std::max_element(begin(summary.histogram), end(summary.histogram));
+        for (size_t bin = 0; bin < summary.histogram.size(); bin++)
+        {
+            const auto count = summary.histogram[bin];
+            std::cout << "  " << std::setw(10) << summary.min + static_cast<double>(bin) * summary.bin_width << ' '
+                      << std::setw(6) << count << ' ' << std::string(static_cast<size_t>(count * bar_width / most), '#')
+                      << '\n';
+        }
+    }
+
+    [[nodiscard]] auto run_sweep(
+        const FlooringConfig& config,
+        const std::pair<SweepAxis, SweepAxis>& axes,
+        SweepMetric metric,
+        const std::string& matrix_path,
+        const std::string& heatmap_path,
+        unsigned threads) -> int
+    {
+        const auto grid =
+            sweep_layouts(config, slider_sweep_range(axes.first), slider_sweep_range(axes.second), threads);
+        const auto rejected = std::count(begin(grid.planks), end(grid.planks), -1);
+        std::cout << "Configurations: " << grid.planks.size() << ", rejected: " << rejected << '\n';
+
+        if (!matrix_path.empty())
+        {
+            const bool binary = matrix_path.size() >= 4 && matrix_path.compare(matrix_path.size() - 4, 4, ".bin") == 0;
+            std::ofstream matrix{ matrix_path, binary ? std::ios::binary : std::ios::out };
+            if (!matrix)
+            {
+                std::cerr << "Cannot open " << matrix_path << '\n';
+                return 1;
+            }
+            if (binary)
+            {
+                write_sweep_binary(matrix, grid);
+            }
+            else
+            {
+                write_sweep_csv(matrix, grid, metric);
+            }
+        }
+        if (!heatmap_path.empty() && !export_sweep_heatmap(grid, metric, heatmap_path))
+        {
+            std::cerr << "Cannot write " << heatmap_path << '\n';
+            return 1;
+        }
+        return 0;
+    }
+
+    [[nodiscard]] auto run_purchase(
+        const FlooringConfig& config,
+        const std::string& catalogue_path,
+        const std::string& projects_path) -> int
+    {
+        std::ifstream catalogue_in{ catalogue_path };
+        std::ifstream projects_in{ projects_path };
+        if (!catalogue_in || !projects_in)
+        {
+            std::cerr << "Cannot open " << (catalogue_in ? projects_path : catalogue_path) << '\n';
+            return 1;
+        }
+        const PurchasePlanner planner{ read_catalogue(catalogue_in) };
+        const auto projects = read_projects(projects_in);
+
+        Workspace workspace;
+        std::vector<PurchaseJob> jobs;
+        jobs.reserve(projects.size());
+        for (const auto& project : projects)
+        {
+            auto project_config = config;
+            project_config.room_size = from_centimetres(project.room_size);
+            const auto result = Flooring::calculate(project_config, workspace);
+            if (!result)
+            {
+                std::cerr << project.name << ": " << describe(result.error()) << '\n';
+                return 1;
+            }
+            jobs.push_back(make_purchase_job(*result, project.waste_reserve_percent));
+        }
+
+        // every product builds one cost table for the whole batch
+        const auto purchases = planner.plan(jobs);
+        std::cout << "project,planks needed,product,planks bought,price,boxes\n";
+        for (size_t i = 0; i < projects.size(); i++)
+        {
+            const auto& purchase = purchases[i];
+            std::cout << projects[i].name << ',' << jobs[i].planks_needed << ',';
+            if (!purchase.feasible)
+            {
+                std::cout << ",,,\n";
+                continue;
+            }
+            const auto& product = planner.product(purchase.product);
+            static constexpr auto cents_per_unit = 100;
+            std::cout << product.name << ',' << purchase.planks << ',' << purchase.price / cents_per_unit << '.'
+                      << std::setw(2) << std::setfill('0') << purchase.price % cents_per_unit << std::setfill(' ')
+                      << ',';
+            const char* separator = "";
+            for (size_t box = 0; box < product.boxes.size(); box++)
+            {
+                if (purchase.box_counts[box] > 0)
+                {
+                    std::cout << separator << purchase.box_counts[box] << 'x' << product.boxes[box].planks_per_box;
+                    separator = " ";
+                }
+            }
+            std::cout << '\n';
+        }
+        return 0;
+    }
+
+    void print_row_offsets(const FlooringConfig& config, int count)
+    {
+        const auto scores = rank_row_offsets(config, from_centimetres(SHORT_PIECE_LENGTH), from_centimetres(1));
+        std::cout << "First piece, last piece, waste (* marks a short piece)\n";
+        for (size_t i = 0; i < std::min(scores.size(), static_cast<size_t>(std::max(count, 0))); i++)
+        {
+            const auto& score = scores[i];
+            const auto first_piece = (score.offset == 0) ? config.plank_size.first : score.offset;
+            const auto last_piece = (score.end_cut == 0) ? config.plank_size.first : score.end_cut;
+            std::cout << first_piece << ", " << last_piece << ", " << score.waste << (score.short_piece ? " *" : "")
+                      << '\n';
+        }
+    }
+
+    void print_distribution(const LayoutDistribution& distribution, std::uint64_t first_seed)
+    {
+        std::cout << "Runs: " << distribution.runs << ", seeds " << first_seed << " to "
+                  << first_seed + static_cast<std::uint64_t>(distribution.runs) - 1 << '\n';
+        print_summary("Planks needed", distribution.planks);
+        print_summary("Waste percent", distribution.waste_percent);
+    }
+
+    void print_counts(const Result& result)
+    {
+        std::cout << "Planks needed: " << result.all_planks << '\n'
+                  << "Left over pieces: " << result.left_over << '\n'
+                  << "Uncut planks: " << result.uncut << '\n';
+    }
+
+    void print_seed(const Result& result)
+    {
+        std::cout << "Seed: " << result.seed << '\n';
+    }
+
+    void print_result(const FlooringConfig& config, const Result& result)
+    {
+        const auto metrics =
+            LayoutMetricsCalculator{ from_centimetres(SHORT_PIECE_LENGTH), config.min_joint_spacing }.compute(result);
+
+        print_counts(result);
+        std::cout << "Min joint offset: " << metrics.min_joint_offset << '\n'
+                  << "Average joint offset: " << metrics.average_joint_offset << '\n'
+                  << "Short pieces: " << metrics.short_pieces << '\n'
+                  << "Repeated rows: " << metrics.repeated_rows << '\n';
+        if (config.min_joint_spacing > 0)
+        {
+            std::cout << "Joints closer than the spacing: " << metrics.close_joints << '\n';
+        }
+    }
+}
+
+auto run_cli(int argc, char* argv[]) -> int
+{
+    const std::vector<std::string> args(argv + 1, argv + argc);
+
+    std::pair<int, int> room_size{ DEFAULT_ROOM_SIZE };
+    std::pair<int, int> plank_size{ DEFAULT_PLANK_SIZE };
+    int min_joint_spacing = DEFAULT_MIN_JOINT_SPACING;
+    bool staggered = true;
+    bool randomize = false;
+    std::string csv_path{};
+    std::string inventory_path{};
+    bool counts_only = false;
+    std::optional<unsigned> threads{};
+    int distribution_runs = 0;
+    int offset_count = 0;
+    std::optional<std::uint64_t> seed{};
+    std::optional<std::pair<SweepAxis, SweepAxis>> sweep_axes{};
+    SweepMetric sweep_metric = SweepMetric::waste_percent;
+    std::string matrix_path{};
+    std::string heatmap_path{};
+    std::optional<std::pair<std::string, std::string>> purchase_paths{};
+
+    try
+    {
+        for (size_t i = 0; i < args.size(); i++)
+        {
+            if (args[i] == "--room" && i + 2 < args.size())
+            {
+                room_size = { std::stoi(args[i + 1]), std::stoi(args[i + 2]) };
+                i += 2;
+            }
+            else if (args[i] == "--plank" && i + 2 < args.size())
+            {
+                plank_size = { std::stoi(args[i + 1]), std::stoi(args[i + 2]) };
+                i += 2;
+            }
+            else if (args[i] == "--spacing" && i + 1 < args.size())
+            {
+                min_joint_spacing = std::stoi(args[++i]);
+            }
+            else if (args[i] == "--seed" && i + 1 < args.size())
+            {
+                seed = std::stoull(args[++i]);
+            }
+            else if (args[i] == "--threads" && i + 1 < args.size())
+            {
+                threads = static_cast<unsigned>(std::stoul(args[++i]));
+            }
+            else if (args[i] == "--inventory" && i + 1 < args.size())
+            {
+                inventory_path = args[++i];
+            }
+            else if (args[i] == "--distribution" && i + 1 < args.size())
+            {
+                distribution_runs = std::stoi(args[++i]);
+            }
+            else if (args[i] == "--sweep" && i + 2 < args.size())
+            {
+                const auto x_axis = parse_sweep_axis(args[i + 1]);
+                const auto y_axis = parse_sweep_axis(args[i + 2]);
+                if (!x_axis || !y_axis || x_axis == y_axis)
+                {
+                    print_usage();
+                    return 1;
+                }
+                sweep_axes = { *x_axis, *y_axis };
+                i += 2;
+            }
+            else if (args[i] == "--metric" && i + 1 < args.size() && (args[i + 1] == "planks" || args[i + 1] == "waste"))
+            {
+                sweep_metric = (args[++i] == "planks") ? SweepMetric::planks : SweepMetric::waste_percent;
+            }
+            else if (args[i] == "--matrix" && i + 1 < args.size())
+            {
+                matrix_path = args[++i];
+            }
+            else if (args[i] == "--heatmap" && i + 1 < args.size())
+            {
+                heatmap_path = args[++i];
+            }
+            else if (args[i] == "--offsets" && i + 1 < args.size())
+            {
+                offset_count = std::stoi(args[++i]);
+            }
+            else if (args[i] == "--purchase" && i + 2 < args.size())
+            {
+                purchase_paths = { args[i + 1], args[i + 2] };
+                i += 2;
+            }
+            else if (args[i] == "--csv" && i + 1 < args.size())
+            {
+                csv_path = args[++i];
+            }
+            else if (args[i] == "--counts")
+            {
+                counts_only = true;
+            }
+            else if (args[i] == "--no-stagger")
+            {
+                staggered = false;
+            }
+            else if (args[i] == "--random")
+            {
+                randomize = true;
+            }
+            else
+            {
+                print_usage();
+                return 1;
+            }
+        }
+
+        // deterministic counts in the slider ranges come from the precomputed tables
+        if (counts_only && staggered && !randomize && inventory_path.empty())
+        {
+            if (const auto counts = lookup_layout_counts(room_size, plank_size))
+            {
+                print_counts({ counts->all_planks, counts->left_over, counts->uncut, {}, {} });
+                return 0;
+            }
+        }
+
+        const FlooringConfig config{ from_centimetres(room_size),
+                                     from_centimetres(plank_size),
+                                     staggered,
+                                     randomize,
+                                     from_centimetres(min_joint_spacing),
+                                     seed };
+        if (const auto error = Flooring::validate(config))
+        {
+            std::cerr << describe(*error) << '\n';
+            return 1;
+        }
+
+        if (offset_count > 0)
+        {
+            print_row_offsets(config, offset_count);
+            return 0;
+        }
+        if (purchase_paths)
+        {
+            return run_purchase(config, purchase_paths->first, purchase_paths->second);
+        }
+        if (sweep_axes)
+        {
+            return run_sweep(config, *sweep_axes, sweep_metric, matrix_path, heatmap_path, threads.value_or(0));
+        }
+
+        if (distribution_runs > 0)
+        {
+            DistributionOptions options{};
+            options.runs = distribution_runs;
+            options.thread_count = threads.value_or(0);
+            options.first_seed = seed.value_or(options.first_seed);
+            print_distribution(*sample_layouts(config, options), options.first_seed);
+            return 0;
+        }
+
+        Workspace workspace;
+        std::optional<LeftoverInventory> inventory{};
+        if (!inventory_path.empty())
+        {
+            inventory.emplace(inventory_path);
+            workspace.inventory = &*inventory;
+        }
+
+        if (counts_only || csv_path.empty())
+        {
+            // --threads 0 cuts the rows on all cores
+            const auto result = threads ? Flooring::calculate_parallel(config, workspace, *threads)
+                                        : Flooring::calculate(config, workspace);
+            if (counts_only)
+            {
+                print_counts(*result);
+            }
+            else
+            {
+                print_result(config, *result);
+            }
+            print_seed(*result);
+        }
+        else
+        {
+            // stream the planks to the file, nothing is kept for the metrics
+            std::ofstream csv{ csv_path };
+            if (!csv)
+            {
+                std::cerr << "Cannot open " << csv_path << '\n';
+                return 1;
+            }
+            const auto result = Flooring::calculate(config, workspace, CsvPlankWriter{ csv });
+            print_counts(*result);
+            print_seed(*result);
+        }
+
+        if (inventory)
+        {
+            std::cout << "Pieces in the inventory: " << inventory->size() << '\n';
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+        print_usage();
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "compact_result.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+
+CompactResult::CompactResult(const Result& result)
+    : all_planks_(result.all_planks),
+      left_over_(result.left_over),
+      uncut_(result.uncut),
+      left_over_pieces_(result.left_over_pieces),
+      seed_(result.seed),
+      left_over_positions_(result.left_over_positions)
+{
+    std::map<std::vector<RowPiece>, size_t> template_ids;
+
+    // ids are handed out in placement order, so an id above every id seen so far is a new plank
+    int highest_id = 0;
+    size_t begin = 0;
+    while (begin < result.planks.size())
+    {
+        const auto y = result.planks[begin].position_.second;
+        RowInstance row{ y, 0, highest_id + 1, left_over_ids_.size() };
+        std::vector<RowPiece> pieces;
+
+        auto end = begin;
+        for (; end < result.planks.size() && result.planks[end].position_.second == y; end++)
+        {
+            const auto& p = result.planks[end];
+            const bool from_left_over = p.id_ <= highest_id;
+            if (from_left_over)
+            {
+                left_over_ids_.push_back(p.id_);
+            }
+            else
+            {
+                highest_id = p.id_;
+            }
+            pieces.push_back({ p.position_.first, p.dimensions_.first, p.dimensions_.second, from_left_over });
+        }
+
+        const auto [known, inserted] = template_ids.try_emplace(std::move(pieces), templates_.size());
+        if (inserted)
+        {
+            templates_.push_back({ known->first });
+        }
+        row.template_id = known->second;
+        rows_.push_back(row);
+
+        begin = end;
+    }
+
+#ifdef FLOORING_CHECK_LAYOUTS
+    // the templates have to give back the planks they were built from
+    size_t index = 0;
+    size_t mismatches = 0;
+    for_each_plank([&](const Plank& plank) {
+        if (index >= result.planks.size() || plank.id_ != result.planks[index].id_ ||
+            plank.position_ != result.planks[index].position_ || plank.dimensions_ != result.planks[index].dimensions_)
+        {
+            mismatches++;
+        }
+        index++;
+    });
+    if (mismatches > 0 || index != result.planks.size())
+    {
+        std::cerr << "Compact result check failed: " << mismatches << " of " << index << " expanded planks differ from "
+                  << result.planks.size() << " planks\n";
+        std::abort();
+    }
+#endif
+}
+
+auto CompactResult::expand_row(size_t row) const -> std::vector<Plank>
+{
+    const auto& instance = rows_.at(row);
+
+    std::vector<Plank> planks;
+    planks.reserve(templates_[instance.template_id].pieces.size());
+    visit_row(instance, [&](Plank plank) { planks.push_back(std::move(plank)); });
+    return planks;
+}
+
+auto CompactResult::expand() const -> Result
+{
+    Result result{ all_planks_, left_over_, uncut_, {}, left_over_pieces_, seed_, left_over_positions_ };
+    for_each_plank([&](Plank plank) { result.planks.push_back(std::move(plank)); });
+    return result;
+}
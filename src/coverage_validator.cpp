@@ -0,0 +1,135 @@
+#include "coverage_validator.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    // cells in the bitplanes of one band
+    constexpr size_t BAND_CELLS = size_t{ 1 } << 24U;
+    constexpr size_t WORD_BITS = 64;
+    constexpr std::uint64_t ALL_BITS = ~std::uint64_t{ 0 };
+
+    auto popcount(std::uint64_t word) -> std::int64_t
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(word);
+#else
+        word = word - ((word >> 1U) & 0x5555555555555555ULL);
+        word = (word & 0x3333333333333333ULL) + ((word >> 2U) & 0x3333333333333333ULL);
+        word = (word + (word >> 4U)) & 0x0f0f0f0f0f0f0f0fULL;
+        return static_cast<std::int64_t>((word * 0x0101010101010101ULL) >> 56U);
+#endif
+    }
+}
+
+void CoverageValidator::mark(size_t row_word, size_t first_cell, size_t end_cell)
+{
+    const auto first_word = first_cell / WORD_BITS;
+    const auto last_word = (end_cell - 1) / WORD_BITS;
+    for (auto word = first_word; word <= last_word; word++)
+    {
+        auto mask = ALL_BITS;
+        if (word == first_word)
+        {
+            mask &= ALL_BITS << (first_cell % WORD_BITS);
+        }
+        if (word == last_word)
+        {
+            mask &= ALL_BITS >> (WORD_BITS - 1 - (end_cell - 1) % WORD_BITS);
+        }
+        overlap_[row_word + word] |= covered_[row_word + word] & mask;
+        covered_[row_word + word] |= mask;
+    }
+}
+
+auto CoverageValidator::check(const std::pair<Length, Length>& room_size, const std::vector<Plank>& planks)
+    -> CoverageReport
+{
+    CoverageReport report{};
+    if (room_size.first <= 0 || room_size.second <= 0)
+    {
+        return report;
+    }
+
+    // coarsest grid every edge falls on
+    auto cell = std::gcd(room_size.first, room_size.second);
+    Length deepest = 0;
+    for (const auto& p : planks)
+    {
+        cell = std::gcd(cell, std::gcd(p.position_.first, p.position_.second));
+        cell = std::gcd(cell, std::gcd(p.dimensions_.first, p.dimensions_.second));
+        deepest = std::max<Length>(deepest, p.dimensions_.second);
+    }
+    report.cell_size = cell;
+
+    const auto columns = static_cast<size_t>(room_size.first / cell);
+    const auto rows = static_cast<size_t>(room_size.second / cell);
+    const auto words_per_row = (columns + WORD_BITS - 1) / WORD_BITS;
+    const auto band_rows = std::max<size_t>(1, BAND_CELLS / (words_per_row * WORD_BITS));
+    const auto deepest_rows = static_cast<size_t>(deepest / cell);
+
+    // planks sorted by their first cell row, a band only looks at the ones that can reach into it;
+    // calculated floors come in row order already
+    order_.resize(planks.size());
+    std::iota(begin(order_), end(order_), size_t{ 0 });
+    const auto by_row = [&](size_t lhs, size_t rhs) { return planks[lhs].position_.second < planks[rhs].position_.second; };
+    if (!std::is_sorted(begin(order_), end(order_), by_row))
+    {
+        std::stable_sort(begin(order_), end(order_), by_row);
+    }
+
+    for (const auto& p : planks)
+    {
+        const std::pair<Length, Length> position = p.position_;
+        const std::pair<Length, Length> dimensions = p.dimensions_;
+        if (dimensions.first <= 0 || dimensions.second <= 0 || position.first < 0 || position.second < 0 ||
+            position.first + dimensions.first > room_size.first || position.second + dimensions.second > room_size.second)
+        {
+            report.planks_outside_room++;
+        }
+    }
+
+    const auto last_word_mask = ALL_BITS >> (words_per_row * WORD_BITS - columns);
+    for (size_t band = 0; band < rows; band += band_rows)
+    {
+        const auto band_end = std::min(rows, band + band_rows);
+        covered_.assign((band_end - band) * words_per_row, 0);
+        overlap_.assign(covered_.size(), 0);
+
+        const auto reach = static_cast<Length>((band > deepest_rows) ? band - deepest_rows : 0) * cell;
+        auto it = std::lower_bound(begin(order_), end(order_), reach, [&](size_t index, Length y) {
+            return planks[index].position_.second < y;
+        });
+        for (; it != end(order_) && planks[*it].position_.second < static_cast<Length>(band_end) * cell; ++it)
+        {
+            const auto& p = planks[*it];
+
+            // clip to the room and the band, planks reaching out of the room are already counted
+            const auto x0 = std::max<Length>(p.position_.first, 0) / cell;
+            const auto x1 = std::min<Length>(p.position_.first + p.dimensions_.first, room_size.first) / cell;
+            const auto y0 = std::max<Length>(p.position_.second / cell, static_cast<Length>(band));
+            const auto y1 = std::min((p.position_.second + p.dimensions_.second) / cell, static_cast<Length>(band_end));
+            if (x0 >= x1)
+            {
+                continue;
+            }
+            for (auto y = y0; y < y1; y++)
+            {
+                mark((static_cast<size_t>(y) - band) * words_per_row, static_cast<size_t>(x0), static_cast<size_t>(x1));
+            }
+        }
+
+        for (size_t row_word = 0; row_word < covered_.size(); row_word += words_per_row)
+        {
+            for (size_t word = 0; word < words_per_row; word++)
+            {
+                const auto inside = (word + 1 == words_per_row) ? last_word_mask : ALL_BITS;
+                report.gap_cells += popcount(~covered_[row_word + word] & inside);
+                report.overlap_cells += popcount(overlap_[row_word + word]);
+            }
+        }
+    }
+
+    return report;
+}
@@ -1,191 +1,219 @@
 #include "flooring.h"
 
-#include "random_generator.h"
+#include <cstdlib>
+#include <iostream>
 
-auto Flooring::generate_color() -> Color
-{
-    static constexpr auto min_value = 100;
-    static constexpr auto max_value = 255;
-
-    return { static_cast<unsigned char>(random_pick(min_value, max_value)),
-             static_cast<unsigned char>(random_pick(min_value, max_value)),
-             static_cast<unsigned char>(random_pick(min_value, max_value)),
-             max_value };
-}
+#include "coverage_validator.h"
+#include "layout_tables.h"
+#include "sweep_validator.h"
 
-auto Flooring::generate_lengths(int start, int end) -> int
+namespace
 {
-    return random_pick(start, end);
-}
+#ifdef FLOORING_CHECK_LAYOUTS
+// floors up to 100 m2 are checked on a raster, larger ones by the sweep, as the raster grows with the area
+constexpr Length RASTER_CHECK_MAX_AREA = Length{ 100 } * 1000 * 1000;
 
-auto Flooring::calculate_slice() -> std::pair<int, int>
+// the compile-time tables count with their own copy of the deterministic engine, which has to keep agreeing with it
+void check_table_counts(const FlooringConfig& config)
 {
-    std::pair<int, int> slice{ 0, 0 };
-
-    if (current_position_.first == 0 && staggered_)
-    {
-        const auto stagger_value = STAGGER_PATTERN.at(stagger_pattern_index_);
-        slice.first = (stagger_value < 0) ? plank_size_.first + stagger_value : stagger_value;
-    }
-    else if ((current_position_.first + plank_size_.first) > room_size_.first)
-    {
-        slice.first = room_size_.first - current_position_.first;
-    }
-    else if (randomize_lengths_)
+    if (config.randomize_lengths)
     {
-        static constexpr auto min_random_slice = 40;
-        slice.first = generate_lengths(min_random_slice, plank_size_.first);
-
-        // clamp the random value
-        if ((current_position_.first + slice.first) > room_size_.first)
-        {
-            slice.first = slice.first - ((current_position_.first + slice.first) - room_size_.first);
-        }
+        return;
     }
-
-    // check the row length again
-    if ((current_position_.first + slice.first) > room_size_.first)
+    const auto table = config.staggered ? count_layout<PatternStagger>(config.room_size, config.plank_size)
+                                        : count_layout<NoStagger>(config.room_size, config.plank_size);
+    if (!table.valid)
     {
-        throw std::length_error("Error: Row width exceeds room size.");
+        return;
     }
 
-    if ((current_position_.second + plank_size_.second) > room_size_.second)
+    thread_local Workspace workspace;
+    (void)Flooring::count_planks(config, workspace);
+    const auto engine = Flooring::summary(config, workspace);
+    if (!(table == LayoutCounts{ engine.all_planks, engine.left_over, engine.uncut, true }))
     {
-        slice.second = room_size_.second - current_position_.second;
+        std::cerr << "Layout table check failed: count_layout gives " << table.all_planks << '/' << table.left_over
+                  << '/' << table.uncut << " planks/left over/uncut, the engine " << engine.all_planks << '/'
+                  << engine.left_over << '/' << engine.uncut << '\n';
+        std::abort();
     }
-
-    // check the col length again
-    if ((current_position_.second + slice.second) > room_size_.second)
-    {
-        throw std::length_error("Error: Column height exceeds room size.");
-    }
-
-    return slice;
 }
-void Flooring::increment_position(const std::pair<int, int> &offset)
+#endif
+
+// builds with FLOORING_CHECK_LAYOUTS, which CMake sets for Debug builds, verify every calculated floor
+auto checked(const FlooringConfig& config, FlooringResult result) -> FlooringResult
 {
-    current_position_.first += offset.first;
-    if (current_position_.first >= room_size_.first)
+#ifdef FLOORING_CHECK_LAYOUTS
+    if (result)
     {
-        current_position_.second += offset.second;
-        current_position_.first = 0;
-        if (staggered_)
+        check_table_counts(config);
+
+        thread_local SweepValidator sweep;
+        if (config.room_size.first * config.room_size.second <= RASTER_CHECK_MAX_AREA)
         {
-            stagger_pattern_index_++;
-            if (stagger_pattern_index_ > STAGGER_PATTERN_SIZE - 1)
+            thread_local CoverageValidator raster;
+            const auto coverage = raster.check(config.room_size, result->planks);
+            const auto overused = sweep.overused_ids(config, *result);
+            if (!coverage.covers_exactly_once() || !overused.empty())
             {
-                stagger_pattern_index_ = 0;
+                std::cerr << "Layout check failed: " << coverage.gap_cells << " gap and " << coverage.overlap_cells
+                          << " overlapping cells of " << coverage.cell_size << " mm, " << coverage.planks_outside_room
+                          << " planks outside the room, " << overused.size() << " plank ids used more than once\n";
+                std::abort();
             }
+            return result;
         }
-    }
-}
 
-void Flooring::cleanup_left_over_pieces()
-{
-    left_over_pieces_.erase(
-        std::remove_if(
-            left_over_pieces_.begin(),
-            left_over_pieces_.end(),
-            [](const auto &p) { return p.dimensions_.first <= 0 || p.dimensions_.second <= 0; }),
-        left_over_pieces_.end());
-}
-
-void Flooring::position_left_over_pieces()
-{
-    int left_over_col = 0;
-    int left_over_row = 1;
-    static constexpr auto left_over_offset = 10;
-    for (auto &lo : left_over_pieces_)
-    {
-        lo.position_ = { left_over_col * (plank_size_.first + left_over_offset),
-                         room_size_.second + (left_over_row * (plank_size_.second + left_over_offset)) };
-        left_over_col++;
-        if (left_over_col > 4)
+        const auto report = sweep.check(config, *result);
+        if (!report.is_exact())
         {
-            left_over_col = 0;
-            left_over_row++;
+            std::cerr << "Layout check failed: " << report.gap_area << " mm2 gap, " << report.overlapping_planks
+                      << " overlapping planks, " << report.planks_outside_room << " planks outside the room, "
+                      << report.overused_ids.size() << " plank ids used more than once\n";
+            std::abort();
         }
     }
+#else
+    (void)config;
+#endif
+    return result;
 }
 
-auto Flooring::find_and_place_usable_piece(
-    bool is_sliced_horizontally,
-    bool is_sliced_vertically,
-    const std::pair<int, int> &size_lookup) -> bool
+// calls the visitor with the engine specialisation the configuration asks for
+template <class Visitor>
+auto dispatch(const FlooringConfig& config, Visitor&& visitor) -> decltype(auto)
 {
-    auto piece = std::find_if(
-        begin(left_over_pieces_), end(left_over_pieces_), [&](const auto &p) { return p.dimensions_ >= size_lookup; });
-    if (piece == std::end(left_over_pieces_))
+    if (config.staggered && config.randomize_lengths)
     {
-        return false;
+        return visitor(BasicFlooring<PatternStagger, RandomLengths, FirstFitMatch>{});
     }
-
-    if (is_sliced_horizontally)
+    if (config.staggered)
     {
-        (*piece).dimensions_.second -= size_lookup.second;
+        return visitor(BasicFlooring<PatternStagger, FullLengths, FirstFitMatch>{});
     }
-    if (is_sliced_vertically)
+    if (config.randomize_lengths)
     {
-        (*piece).dimensions_.first -= size_lookup.first;
+        return visitor(BasicFlooring<NoStagger, RandomLengths, FirstFitMatch>{});
     }
+    return visitor(BasicFlooring<NoStagger, FullLengths, FirstFitMatch>{});
+}
+} // namespace
+
+void Flooring::configure(
+    const std::pair<Length, Length>& room_size,
+    const std::pair<Length, Length>& plank_size,
+    bool staggered,
+    bool randomize_lengths,
+    Length min_joint_spacing,
+    std::optional<std::uint64_t> seed)
+{
+    config_ = FlooringConfig{ room_size, plank_size, staggered, randomize_lengths, min_joint_spacing, seed };
+}
 
-    planks_.emplace_back((*piece).id_, current_position_, size_lookup, (*piece).color_);
-    return true;
+void Flooring::configure(const FlooringConfig& config)
+{
+    config_ = config;
 }
 
-auto Flooring::calculate() -> Result
+auto Flooring::config() const -> const FlooringConfig&
 {
-    randomize();
+    return config_;
+}
 
-    current_position_ = { 0, 0 };
-    stagger_pattern_index_ = 0;
+auto Flooring::validate(const FlooringConfig& config) -> std::optional<FlooringError>
+{
+    return dispatch(config, [&](auto engine) { return engine.validate(config); });
+}
 
-    planks_.clear();
-    left_over_pieces_.clear();
+auto Flooring::calculate() -> FlooringResult
+{
+    return calculate(config_, workspace_);
+}
 
-    int index = 0;
-    int uncut_planks = 0;
+auto Flooring::calculate(const PlankSink& sink, size_t chunk_size) -> FlooringResult
+{
+    return calculate(config_, workspace_, sink, chunk_size);
+}
+
+auto Flooring::calculate_parallel(unsigned thread_count) -> FlooringResult
+{
+    return calculate_parallel(config_, workspace_, thread_count);
+}
+
+auto Flooring::recalculate() -> FlooringResult
+{
+    return recalculate(config_, workspace_);
+}
+
+auto Flooring::calculate(const FlooringConfig& config, Workspace& workspace) -> FlooringResult
+{
+    return checked(config, dispatch(config, [&](auto engine) { return engine.calculate(config, workspace); }));
+}
 
-    while (current_position_.second < room_size_.second)
+auto Flooring::calculate(const FlooringConfig& config, Workspace& workspace, const PlankSink& sink, size_t chunk_size)
+    -> FlooringResult
+{
+#ifdef FLOORING_CHECK_LAYOUTS
+    // checked builds keep a copy of the streamed planks to verify them, giving up the constant memory of streaming
+    std::vector<Plank> streamed;
+    const PlankSink checked_sink = [&](const std::vector<Plank>& chunk) {
+        streamed.insert(end(streamed), begin(chunk), end(chunk));
+        sink(chunk);
+    };
+    auto result =
+        dispatch(config, [&](auto engine) { return engine.calculate(config, workspace, checked_sink, chunk_size); });
+    if (result)
     {
-        const auto slice = calculate_slice();
-        const bool is_sliced_vertically = slice.first > 0;
-        const bool is_sliced_horizontally = slice.second > 0;
+        auto complete = *result;
+        complete.planks = std::move(streamed);
+        (void)checked(config, std::move(complete));
+    }
+    return result;
+#else
+    return dispatch(config, [&](auto engine) { return engine.calculate(config, workspace, sink, chunk_size); });
+#endif
+}
 
-        if (!is_sliced_horizontally && !is_sliced_vertically)
-        {
-            index++;
-            uncut_planks++;
-            planks_.emplace_back(index, current_position_, plank_size_, generate_color());
-            increment_position(plank_size_);
-            continue;
-        }
+auto Flooring::calculate_parallel(const FlooringConfig& config, Workspace& workspace, unsigned thread_count)
+    -> FlooringResult
+{
+    return checked(
+        config, dispatch(config, [&](auto engine) { return engine.calculate_parallel(config, workspace, thread_count); }));
+}
 
-        // dimensions we are looking for
-        const std::pair<int, int> size_lookup{ is_sliced_vertically ? slice.first : plank_size_.first,
-                                               is_sliced_horizontally ? slice.second : plank_size_.second };
+auto Flooring::recalculate(const FlooringConfig& config, Workspace& workspace) -> FlooringResult
+{
+    return checked(config, dispatch(config, [&](auto engine) { return engine.recalculate(config, workspace); }));
+}
 
-        if (!find_and_place_usable_piece(is_sliced_horizontally, is_sliced_vertically, size_lookup))
-        {
-            const auto color = generate_color();
-
-            // make a new plank
-            index++;
-            planks_.emplace_back(index, current_position_, size_lookup, color);
-
-            // store the remaining part in the left overs
-            const std::pair<int, int> left_over_dimensions = {
-                is_sliced_vertically ? plank_size_.first - size_lookup.first : plank_size_.first,
-                is_sliced_horizontally ? plank_size_.second - size_lookup.second : plank_size_.second
-            };
-            left_over_pieces_.emplace_back(index, std::pair<int, int>{ 0, 0 }, left_over_dimensions, color);
-        }
+void Flooring::start(const FlooringConfig& config, Workspace& workspace)
+{
+    dispatch(config, [&](auto engine) { engine.start(config, workspace); });
+}
 
-        cleanup_left_over_pieces();
-        increment_position(size_lookup);
-    }
+auto Flooring::has_next_plank(const FlooringConfig& config, const Workspace& workspace) -> bool
+{
+    return dispatch(config, [&](auto engine) { return engine.has_next_plank(config, workspace); });
+}
 
-    position_left_over_pieces();
+auto Flooring::place_next_plank(const FlooringConfig& config, Workspace& workspace) -> Plank
+{
+    return dispatch(config, [&](auto engine) { return engine.place_next_plank(config, workspace); });
+}
+
+auto Flooring::summary(const FlooringConfig& config, Workspace& workspace) -> Result
+{
+    return dispatch(config, [&](auto engine) { return engine.summary(config, workspace); });
+}
 
-    return { index, static_cast<int>(left_over_pieces_.size()), uncut_planks, planks_, left_over_pieces_ };
+auto Flooring::count_planks(const FlooringConfig& config, Workspace& workspace) -> int
+{
+    return dispatch(config, [&](auto engine) {
+        engine.start(config, workspace);
+        while (engine.has_next_plank(config, workspace))
+        {
+            (void)engine.place_next_plank(config, workspace);
+        }
+        return workspace.index;
+    });
 }
@@ -0,0 +1,101 @@
+#include "layout_distribution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <numeric>
+#include <thread>
+
+#include "layout_metrics.h"
+
+namespace
+{
+    [[nodiscard]] auto summarize(std::vector<double>& samples, int bins) -> SampleSummary
+    {
+        SampleSummary summary{};
+        if (samples.empty())
+        {
+            return summary;
+        }
+        std::sort(begin(samples), end(samples));
+
+        const auto count = static_cast<double>(samples.size());
+        summary.mean = std::accumulate(begin(samples), end(samples), 0.0) / count;
+        const auto squares = std::accumulate(begin(samples), end(samples), 0.0, [&](double sum, double value) {
+            return sum + (value - summary.mean) * (value - summary.mean);
+        });
+        summary.standard_deviation = std::sqrt(squares / count);
+        summary.min = samples.front();
+        summary.max = samples.back();
+
+        for (size_t i = 0; i < DISTRIBUTION_PERCENTILES.size(); i++)
+        {
+            const auto rank = static_cast<size_t>(std::ceil(DISTRIBUTION_PERCENTILES[i] / 100.0 * count));
+            summary.percentiles[i] = samples[std::max<size_t>(rank, 1) - 1];
+        }
+
+        summary.histogram.assign(static_cast<size_t>(std::max(bins, 1)), 0);
+        summary.bin_width = (summary.max - summary.min) / static_cast<double>(summary.histogram.size());
+        for (const auto value : samples)
+        {
+            // the maximum falls into the last bin, all samples land in the first when they are equal
+            const auto bin = (summary.bin_width > 0.0) ? static_cast<size_t>((value - summary.min) / summary.bin_width)
+                                                       : size_t{ 0 };
+            summary.histogram[std::min(bin, summary.histogram.size() - 1)]++;
+        }
+        return summary;
+    }
+}
+
+auto sample_layouts(const FlooringConfig& config, const DistributionOptions& options)
+    -> Expected<LayoutDistribution, FlooringError>
+{
+    if (const auto error = Flooring::validate(config))
+    {
+        return *error;
+    }
+
+    const auto runs = static_cast<size_t>(std::max(options.runs, 0));
+    std::vector<int> planks(runs);
+
+    auto thread_count = options.thread_count;
+    if (thread_count == 0)
+    {
+        thread_count = std::max(1U, std::thread::hardware_concurrency());
+    }
+    const auto threads = std::max<size_t>(1, std::min<size_t>(thread_count, runs));
+    const auto runs_per_thread = (runs + threads - 1) / threads;
+
+    // every run draws from the streams of its own seed, whichever thread it runs on
+    const auto run_block = [&](size_t first_run) {
+        Workspace workspace;
+        auto run_config = config;
+        const auto last_run = std::min(runs, first_run + runs_per_thread);
+        for (auto run = first_run; run < last_run; run++)
+        {
+            run_config.seed = options.first_seed + run;
+            planks[run] = Flooring::count_planks(run_config, workspace);
+        }
+    };
+    std::vector<std::future<void>> tasks;
+    for (auto first_run = runs_per_thread; first_run < runs; first_run += runs_per_thread)
+    {
+        tasks.push_back(std::async(std::launch::async, run_block, first_run));
+    }
+    run_block(0);
+    for (auto& task : tasks)
+    {
+        task.get();
+    }
+
+    std::vector<double> plank_samples(begin(planks), end(planks));
+    std::vector<double> waste_samples(runs);
+    std::transform(
+        begin(planks), end(planks), begin(waste_samples), [&](int count) { return waste_percent(config, count); });
+
+    LayoutDistribution distribution{};
+    distribution.runs = static_cast<int>(runs);
+    distribution.planks = summarize(plank_samples, options.bins);
+    distribution.waste_percent = summarize(waste_samples, options.bins);
+    return distribution;
+}
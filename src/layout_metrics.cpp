@@ -0,0 +1,159 @@
+#include "layout_metrics.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+
+auto waste_percent(const FlooringConfig& config, int planks) -> double
+{
+    const auto room_area = static_cast<double>(config.room_size.first) * static_cast<double>(config.room_size.second);
+    const auto plank_area = static_cast<double>(config.plank_size.first) * static_cast<double>(config.plank_size.second);
+    const auto bought = planks * plank_area;
+    return (bought > 0.0) ? 100.0 * (bought - room_area) / bought : 0.0;
+}
+
+auto LayoutMetricsCalculator::compute(const Result& result) -> LayoutMetrics
+{
+    LayoutMetrics metrics{};
+
+    collect_joints(result.planks);
+
+    int short_pieces = 0;
+    for (const auto width : widths_)
+    {
+        short_pieces += (width < short_piece_length_) ? 1 : 0;
+    }
+    metrics.short_pieces = short_pieces;
+
+    pair_joints();
+    measure_joint_offsets(metrics);
+    count_repeated_rows(metrics);
+
+    return metrics;
+}
+
+void LayoutMetricsCalculator::collect_joints(const std::vector<Plank>& planks)
+{
+    joints_.clear();
+    row_begin_.clear();
+    widths_.clear();
+
+    // planks come in row order, left to right, so each row's joints are already sorted;
+    // the end of the last plank in a row is the wall and gets dropped when the next row starts
+    auto row_y = std::numeric_limits<Length>::min();
+    for (const auto& p : planks)
+    {
+        if (p.position_.second != row_y)
+        {
+            if (!row_begin_.empty())
+            {
+                joints_.pop_back();
+            }
+            row_y = p.position_.second;
+            row_begin_.push_back(joints_.size());
+        }
+        joints_.push_back(p.position_.first + p.dimensions_.first);
+        widths_.push_back(p.dimensions_.first);
+    }
+    if (!row_begin_.empty())
+    {
+        joints_.pop_back();
+    }
+    row_begin_.push_back(joints_.size());
+}
+
+void LayoutMetricsCalculator::pair_joints()
+{
+    measured_.clear();
+    left_.clear();
+    right_.clear();
+
+    // merge every row with the row below it, a joint's closest neighbour is next to it in the merged order;
+    // the merge is the only sequential part, it just gathers the two candidates of every joint
+    for (size_t row = 1; row + 1 < row_begin_.size(); row++)
+    {
+        auto below = joints_.begin() + static_cast<std::ptrdiff_t>(row_begin_[row - 1]);
+        const auto below_end = joints_.begin() + static_cast<std::ptrdiff_t>(row_begin_[row]);
+        const auto row_end = joints_.begin() + static_cast<std::ptrdiff_t>(row_begin_[row + 1]);
+        if (below == below_end)
+        {
+            continue;
+        }
+
+        for (auto joint = below_end; joint != row_end; ++joint)
+        {
+            while (std::next(below) != below_end && *std::next(below) <= *joint)
+            {
+                ++below;
+            }
+            measured_.push_back(*joint);
+            left_.push_back(*below);
+            // the last joint of the row below stands in for a missing right neighbour
+            right_.push_back((std::next(below) != below_end) ? *std::next(below) : *below);
+        }
+    }
+}
+
+void LayoutMetricsCalculator::measure_joint_offsets(LayoutMetrics& metrics) const
+{
+    auto min_offset = std::numeric_limits<Length>::max();
+    Length offset_sum = 0;
+    int close_joints = 0;
+
+    // one pass over the flat arrays of all rows, no branch, so the compiler vectorises it
+    const auto count = measured_.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto to_left = measured_[i] - left_[i];
+        const auto to_right = right_[i] - measured_[i];
+        const auto left_offset = (to_left < 0) ? -to_left : to_left;
+        const auto right_offset = (to_right < 0) ? -to_right : to_right;
+        const auto offset = (right_offset < left_offset) ? right_offset : left_offset;
+        min_offset = (offset < min_offset) ? offset : min_offset;
+        offset_sum += offset;
+        close_joints += (offset < min_joint_spacing_) ? 1 : 0;
+    }
+
+    metrics.measured_joints = static_cast<int>(count);
+    metrics.close_joints = close_joints;
+    if (count > 0)
+    {
+        metrics.min_joint_offset = min_offset;
+        metrics.average_joint_offset = static_cast<double>(offset_sum) / static_cast<double>(count);
+    }
+}
+
+void LayoutMetricsCalculator::count_repeated_rows(LayoutMetrics& metrics)
+{
+    row_hashes_.clear();
+
+    for (size_t row = 0; row + 1 < row_begin_.size(); row++)
+    {
+        const auto first = joints_.begin() + static_cast<std::ptrdiff_t>(row_begin_[row]);
+        const auto last = joints_.begin() + static_cast<std::ptrdiff_t>(row_begin_[row + 1]);
+
+        // FNV-1a over the joint positions
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (auto joint = first; joint != last; ++joint)
+        {
+            hash = (hash ^ static_cast<std::uint64_t>(*joint)) * 1099511628211ULL;
+        }
+
+        const auto [match_begin, match_end] = row_hashes_.equal_range(hash);
+        const auto repeated = std::any_of(match_begin, match_end, [&](const auto& match) {
+            const auto other = joints_.begin() + static_cast<std::ptrdiff_t>(row_begin_[match.second]);
+            const auto other_end = joints_.begin() + static_cast<std::ptrdiff_t>(row_begin_[match.second + 1]);
+            return std::equal(first, last, other, other_end);
+        });
+
+        if (repeated)
+        {
+            metrics.repeated_rows++;
+        }
+        else
+        {
+            row_hashes_.emplace(hash, row);
+        }
+    }
+}
@@ -0,0 +1,227 @@
+#include "layout_sweep.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <thread>
+
+#include "config.h"
+#include "layout_metrics.h"
+#include "raylib.h"
+
+namespace
+{
+    // cells taken from the shared counter at a time, small enough to balance rows of very different cost
+    constexpr size_t SWEEP_CHUNK_CELLS = 64;
+
+    constexpr std::array<const char*, 4> AXIS_NAMES{ "room-width", "room-depth", "plank-length", "plank-depth" };
+    constexpr std::array<char, 8> SWEEP_MAGIC{ { 'P', 'L', 'A', 'N', 'K', 'S', 'W', 'P' } };
+
+    void set_axis(FlooringConfig& config, SweepAxis axis, Length value)
+    {
+        switch (axis)
+        {
+        case SweepAxis::room_width:
+            config.room_size.first = value;
+            break;
+        case SweepAxis::room_depth:
+            config.room_size.second = value;
+            break;
+        case SweepAxis::plank_length:
+            config.plank_size.first = value;
+            break;
+        case SweepAxis::plank_depth:
+            config.plank_size.second = value;
+            break;
+        }
+    }
+
+    template <class T>
+    void write_value(std::ostream& out, const T& value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <class T>
+    void write_values(std::ostream& out, const std::vector<T>& values)
+    {
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+}
+
+auto parse_sweep_axis(const std::string& name) -> std::optional<SweepAxis>
+{
+    const auto it = std::find(begin(AXIS_NAMES), end(AXIS_NAMES), name);
+    if (it == end(AXIS_NAMES))
+    {
+        return std::nullopt;
+    }
+    return static_cast<SweepAxis>(it - begin(AXIS_NAMES));
+}
+
+auto sweep_axis_name(SweepAxis axis) -> const char*
+{
+    return AXIS_NAMES[static_cast<size_t>(axis)];
+}
+
+auto slider_sweep_range(SweepAxis axis) -> SweepRange
+{
+    const auto range = [&] {
+        switch (axis)
+        {
+        case SweepAxis::room_width:
+        case SweepAxis::room_depth:
+            return SLIDER_ROOM_RANGE;
+        case SweepAxis::plank_length:
+            return SLIDER_PLANK_X_RANGE;
+        case SweepAxis::plank_depth:
+            break;
+        }
+        return SLIDER_PLANK_Y_RANGE;
+    }();
+    return { axis, from_centimetres(range.first), from_centimetres(range.second), from_centimetres(1) };
+}
+
+auto SweepGrid::value(SweepMetric metric, size_t cell) const -> double
+{
+    if (metric == SweepMetric::planks)
+    {
+        return planks[cell];
+    }
+    return waste_percent[cell];
+}
+
+auto sweep_layouts(const FlooringConfig& base, const SweepRange& columns, const SweepRange& rows, unsigned thread_count)
+    -> SweepGrid
+{
+    SweepGrid grid{ columns, rows };
+    const auto cells = columns.size() * rows.size();
+    grid.planks.assign(cells, -1);
+    grid.waste_percent.assign(cells, std::numeric_limits<float>::quiet_NaN());
+
+    if (thread_count == 0)
+    {
+        thread_count = std::max(1U, std::thread::hardware_concurrency());
+    }
+    const auto threads = std::max<size_t>(1, std::min<size_t>(thread_count, cells / SWEEP_CHUNK_CELLS + 1));
+
+    std::atomic<size_t> next_cell{ 0 };
+    const auto work = [&] {
+        Workspace workspace;
+        auto config = base;
+        for (auto first = next_cell.fetch_add(SWEEP_CHUNK_CELLS); first < cells;
+             first = next_cell.fetch_add(SWEEP_CHUNK_CELLS))
+        {
+            const auto last = std::min(cells, first + SWEEP_CHUNK_CELLS);
+            for (auto cell = first; cell < last; cell++)
+            {
+                set_axis(config, columns.axis, columns.value(cell % columns.size()));
+                set_axis(config, rows.axis, rows.value(cell / columns.size()));
+                if (Flooring::validate(config))
+                {
+                    continue;
+                }
+                const auto planks = Flooring::count_planks(config, workspace);
+                grid.planks[cell] = planks;
+                grid.waste_percent[cell] = static_cast<float>(waste_percent(config, planks));
+            }
+        }
+    };
+
+    std::vector<std::future<void>> tasks;
+    for (size_t thread = 1; thread < threads; thread++)
+    {
+        tasks.push_back(std::async(std::launch::async, work));
+    }
+    work();
+    for (auto& task : tasks)
+    {
+        task.get();
+    }
+
+    return grid;
+}
+
+void write_sweep_csv(std::ostream& out, const SweepGrid& grid, SweepMetric metric)
+{
+    out << sweep_axis_name(grid.rows.axis) << '\\' << sweep_axis_name(grid.columns.axis);
+    for (size_t column = 0; column < grid.columns.size(); column++)
+    {
+        out << ',' << grid.columns.value(column);
+    }
+    out << '\n';
+
+    for (size_t row = 0; row < grid.rows.size(); row++)
+    {
+        out << grid.rows.value(row);
+        for (size_t column = 0; column < grid.columns.size(); column++)
+        {
+            const auto cell = row * grid.columns.size() + column;
+            out << ',';
+            // rejected cells stay empty
+            if (grid.planks[cell] >= 0)
+            {
+                out << grid.value(metric, cell);
+            }
+        }
+        out << '\n';
+    }
+}
+
+void write_sweep_binary(std::ostream& out, const SweepGrid& grid)
+{
+    out.write(SWEEP_MAGIC.data(), SWEEP_MAGIC.size());
+    for (const auto& range : { grid.columns, grid.rows })
+    {
+        write_value(out, static_cast<std::int64_t>(range.axis));
+        write_value(out, static_cast<std::int64_t>(range.first));
+        write_value(out, static_cast<std::int64_t>(range.step));
+        write_value(out, static_cast<std::int64_t>(range.size()));
+    }
+    const std::vector<std::int32_t> planks(begin(grid.planks), end(grid.planks));
+    write_values(out, planks);
+    write_values(out, grid.waste_percent);
+}
+
+auto export_sweep_heatmap(const SweepGrid& grid, SweepMetric metric, const std::string& path) -> bool
+{
+    const auto width = static_cast<int>(grid.columns.size());
+    const auto height = static_cast<int>(grid.rows.size());
+    if (width == 0 || height == 0)
+    {
+        return false;
+    }
+
+    auto low = std::numeric_limits<double>::max();
+    auto high = std::numeric_limits<double>::lowest();
+    for (size_t cell = 0; cell < grid.planks.size(); cell++)
+    {
+        if (grid.planks[cell] >= 0)
+        {
+            low = std::min(low, grid.value(metric, cell));
+            high = std::max(high, grid.value(metric, cell));
+        }
+    }
+
+    static constexpr float blue_hue = 240.0f;
+    auto image = GenImageColor(width, height, BLACK);
+    for (size_t cell = 0; cell < grid.planks.size(); cell++)
+    {
+        if (grid.planks[cell] < 0)
+        {
+            continue;
+        }
+        const auto share = (high > low) ? (grid.value(metric, cell) - low) / (high - low) : 0.0;
+        ImageDrawPixel(
+            &image,
+            static_cast<int>(cell % grid.columns.size()),
+            static_cast<int>(cell / grid.columns.size()),
+            ColorFromHSV(blue_hue * static_cast<float>(1.0 - share), 0.85f, 0.95f));
+    }
+    const auto exported = ExportImage(image, path.c_str());
+    UnloadImage(image);
+    return exported;
+}
@@ -0,0 +1,87 @@
+#include "layout_tables.h"
+
+#include "config.h"
+
+namespace
+{
+    // regression tests, evaluated by the compiler
+    static_assert(count_layout({ 5600, 4000 }, { 1300, 250 }) == LayoutCounts{ 70, 7, 56, true });
+    static_assert(count_layout({ 5600, 4010 }, { 1300, 250 }) == LayoutCounts{ 72, 8, 56, true });
+    static_assert(count_layout({ 2000, 2000 }, { 600, 100 }) == LayoutCounts{ 70, 16, 47, true });
+    static_assert(count_layout({ 8010, 8010 }, { 3010, 1000 }) == LayoutCounts{ 26, 12, 14, true });
+    static_assert(count_layout({ 3330, 5170 }, { 770, 330 }) == LayoutCounts{ 72, 18, 50, true });
+    static_assert(!count_layout({ 400, 4000 }, { 1300, 250 }).valid);
+
+    template <size_t Size, class Configuration>
+    constexpr auto make_table(int first, Configuration configuration) -> std::array<LayoutCounts, Size>
+    {
+        std::array<LayoutCounts, Size> table{};
+        for (size_t i = 0; i < Size; i++)
+        {
+            const auto [room_size, plank_size] = configuration(first + static_cast<int>(i));
+            table[i] = count_layout(from_centimetres(room_size), from_centimetres(plank_size));
+        }
+        return table;
+    }
+
+    constexpr auto range_size(const std::pair<int, int>& range) -> size_t
+    {
+        return static_cast<size_t>(range.second - range.first + 1);
+    }
+
+    constexpr auto ROOM_WIDTH_TABLE = make_table<range_size(SLIDER_ROOM_RANGE)>(SLIDER_ROOM_RANGE.first, [](int value) {
+        return std::pair{ std::pair{ value, DEFAULT_ROOM_SIZE.second }, DEFAULT_PLANK_SIZE };
+    });
+    constexpr auto ROOM_DEPTH_TABLE = make_table<range_size(SLIDER_ROOM_RANGE)>(SLIDER_ROOM_RANGE.first, [](int value) {
+        return std::pair{ std::pair{ DEFAULT_ROOM_SIZE.first, value }, DEFAULT_PLANK_SIZE };
+    });
+    constexpr auto PLANK_LENGTH_TABLE =
+        make_table<range_size(SLIDER_PLANK_X_RANGE)>(SLIDER_PLANK_X_RANGE.first, [](int value) {
+            return std::pair{ DEFAULT_ROOM_SIZE, std::pair{ value, DEFAULT_PLANK_SIZE.second } };
+        });
+    constexpr auto PLANK_WIDTH_TABLE =
+        make_table<range_size(SLIDER_PLANK_Y_RANGE)>(SLIDER_PLANK_Y_RANGE.first, [](int value) {
+            return std::pair{ DEFAULT_ROOM_SIZE, std::pair{ DEFAULT_PLANK_SIZE.first, value } };
+        });
+
+    // the tables and the function they are built from have to agree
+    static_assert(ROOM_WIDTH_TABLE[560 - SLIDER_ROOM_RANGE.first] == LayoutCounts{ 70, 7, 56, true });
+    static_assert(ROOM_DEPTH_TABLE[401 - SLIDER_ROOM_RANGE.first] == LayoutCounts{ 72, 8, 56, true });
+
+    template <size_t Size>
+    auto lookup(const std::array<LayoutCounts, Size>& table, int first, int value) -> std::optional<LayoutCounts>
+    {
+        if (value < first || value - first >= static_cast<int>(Size) || !table[static_cast<size_t>(value - first)].valid)
+        {
+            return std::nullopt;
+        }
+        return table[static_cast<size_t>(value - first)];
+    }
+}
+
+auto lookup_layout_counts(const std::pair<int, int>& room_size, const std::pair<int, int>& plank_size)
+    -> std::optional<LayoutCounts>
+{
+    const bool default_room_width = room_size.first == DEFAULT_ROOM_SIZE.first;
+    const bool default_room_depth = room_size.second == DEFAULT_ROOM_SIZE.second;
+    const bool default_plank_length = plank_size.first == DEFAULT_PLANK_SIZE.first;
+    const bool default_plank_width = plank_size.second == DEFAULT_PLANK_SIZE.second;
+
+    if (default_room_depth && default_plank_length && default_plank_width)
+    {
+        return lookup(ROOM_WIDTH_TABLE, SLIDER_ROOM_RANGE.first, room_size.first);
+    }
+    if (default_room_width && default_plank_length && default_plank_width)
+    {
+        return lookup(ROOM_DEPTH_TABLE, SLIDER_ROOM_RANGE.first, room_size.second);
+    }
+    if (default_room_width && default_room_depth && default_plank_width)
+    {
+        return lookup(PLANK_LENGTH_TABLE, SLIDER_PLANK_X_RANGE.first, plank_size.first);
+    }
+    if (default_room_width && default_room_depth && default_plank_length)
+    {
+        return lookup(PLANK_WIDTH_TABLE, SLIDER_PLANK_Y_RANGE.first, plank_size.second);
+    }
+    return std::nullopt;
+}
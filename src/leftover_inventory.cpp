@@ -0,0 +1,371 @@
+#include "leftover_inventory.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr std::array<char, 8> INVENTORY_MAGIC{ { 'P', 'L', 'A', 'N', 'K', 'I', 'N', 'V' } };
+    constexpr std::uint32_t INVENTORY_VERSION = 1;
+    constexpr size_t INITIAL_CAPACITY = 64;
+
+    struct InventoryHeader
+    {
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t record_size;
+        std::array<std::uint64_t, 2> reserved;
+    };
+
+    // a slot is free when its checksum does not match, clearing the checksum frees it in a single store
+    struct InventoryRecord
+    {
+        std::int64_t width;
+        std::int64_t height;
+        std::uint64_t serial;
+        std::uint64_t checksum;
+    };
+
+    constexpr size_t HEADER_SIZE = sizeof(InventoryHeader);
+    constexpr size_t RECORD_SIZE = sizeof(InventoryRecord);
+
+    auto record_checksum(const InventoryRecord& record) -> std::uint64_t
+    {
+        // FNV-1a over the fields, 0 is reserved for free slots
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (const auto value : { static_cast<std::uint64_t>(record.width),
+                                  static_cast<std::uint64_t>(record.height),
+                                  record.serial })
+        {
+            for (int byte = 0; byte < 8; byte++)
+            {
+                hash ^= (value >> (8 * byte)) & 0xffU;
+                hash *= 1099511628211ULL;
+            }
+        }
+        return (hash == 0) ? 1 : hash;
+    }
+
+    auto holds_piece(const InventoryRecord& record) -> bool
+    {
+        return record.width > 0 && record.height > 0 && record.checksum == record_checksum(record);
+    }
+}
+
+struct LeftoverInventory::MappedFile
+{
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int descriptor = -1;
+#endif
+    unsigned char* data = nullptr;
+    size_t size = 0;
+
+    explicit MappedFile(const std::string& path)
+    {
+#ifdef _WIN32
+        file = CreateFileA(
+            path.c_str(),
+            GENERIC_READ | GENERIC_WRITE,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr);
+        LARGE_INTEGER file_size{};
+        if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &file_size))
+        {
+            throw std::runtime_error("Cannot open inventory " + path);
+        }
+        const auto existing = static_cast<size_t>(file_size.QuadPart);
+#else
+        descriptor = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        struct stat status
+        {
+        };
+        if (descriptor < 0 || fstat(descriptor, &status) != 0)
+        {
+            throw std::runtime_error("Cannot open inventory " + path);
+        }
+        const auto existing = static_cast<size_t>(status.st_size);
+#endif
+        if (existing == 0)
+        {
+            map(HEADER_SIZE + INITIAL_CAPACITY * RECORD_SIZE);
+            InventoryHeader header{ INVENTORY_MAGIC, INVENTORY_VERSION, static_cast<std::uint32_t>(RECORD_SIZE), {} };
+            std::memcpy(data, &header, sizeof(header));
+            flush();
+            return;
+        }
+
+        if (existing < HEADER_SIZE)
+        {
+            throw std::runtime_error("Not an inventory file: " + path);
+        }
+        map(existing);
+        const auto* header = reinterpret_cast<const InventoryHeader*>(data);
+        if (header->magic != INVENTORY_MAGIC || header->version != INVENTORY_VERSION ||
+            header->record_size != RECORD_SIZE)
+        {
+            throw std::runtime_error("Not an inventory file: " + path);
+        }
+    }
+
+    ~MappedFile()
+    {
+        unmap();
+#ifdef _WIN32
+        if (file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(file);
+        }
+#else
+        if (descriptor >= 0)
+        {
+            close(descriptor);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+    [[nodiscard]] auto capacity() const -> size_t
+    {
+        return (size - HEADER_SIZE) / RECORD_SIZE;
+    }
+
+    [[nodiscard]] auto record(size_t slot) const -> InventoryRecord*
+    {
+        return reinterpret_cast<InventoryRecord*>(data + HEADER_SIZE + slot * RECORD_SIZE);
+    }
+
+    // maps new_size bytes, growing the file first when it is shorter; the new bytes read as zero, so free slots
+    void map(size_t new_size)
+    {
+#ifdef _WIN32
+        const auto high = static_cast<DWORD>(static_cast<std::uint64_t>(new_size) >> 32U);
+        const auto low = static_cast<DWORD>(new_size & 0xffffffffU);
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, high, low, nullptr);
+        void* view = (mapping != nullptr) ? MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, new_size) : nullptr;
+        if (view == nullptr)
+        {
+            throw std::runtime_error("Cannot map the inventory file");
+        }
+#else
+        struct stat status
+        {
+        };
+        if (fstat(descriptor, &status) != 0 ||
+            (static_cast<size_t>(status.st_size) < new_size && ftruncate(descriptor, static_cast<off_t>(new_size)) != 0))
+        {
+            throw std::runtime_error("Cannot grow the inventory file");
+        }
+        void* view = mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+        if (view == MAP_FAILED)
+        {
+            throw std::runtime_error("Cannot map the inventory file");
+        }
+#endif
+        data = static_cast<unsigned char*>(view);
+        size = new_size;
+    }
+
+    void unmap()
+    {
+        if (data == nullptr)
+        {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle(mapping);
+        mapping = nullptr;
+#else
+        munmap(data, size);
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+    void flush() const
+    {
+#ifdef _WIN32
+        FlushViewOfFile(data, size);
+        FlushFileBuffers(file);
+#else
+        msync(data, size, MS_SYNC);
+#endif
+    }
+};
+
+LeftoverInventory::LeftoverInventory(const std::string& path) : file_(std::make_unique<MappedFile>(path))
+{
+    load();
+}
+
+LeftoverInventory::~LeftoverInventory() = default;
+
+void LeftoverInventory::load()
+{
+    // free slots are handed out from the back, lowest slot first
+    for (auto slot = file_->capacity(); slot-- > 0;)
+    {
+        const auto* record = file_->record(slot);
+        if (holds_piece(*record))
+        {
+            add_to_index(slot);
+            next_serial_ = std::max(next_serial_, record->serial + 1);
+        }
+        else
+        {
+            free_slots_.push_back(slot);
+        }
+    }
+}
+
+void LeftoverInventory::add_to_index(size_t slot)
+{
+    const auto* record = file_->record(slot);
+    index_[record->height].emplace(record->width, slot);
+    size_++;
+}
+
+auto LeftoverInventory::acquire_slot() -> size_t
+{
+    if (free_slots_.empty())
+    {
+        const auto capacity = file_->capacity();
+        const auto grown = std::max(INITIAL_CAPACITY, capacity * 2);
+        file_->unmap();
+        file_->map(HEADER_SIZE + grown * RECORD_SIZE);
+        for (auto slot = grown; slot-- > capacity;)
+        {
+            free_slots_.push_back(slot);
+        }
+    }
+
+    const auto slot = free_slots_.back();
+    free_slots_.pop_back();
+    return slot;
+}
+
+auto LeftoverInventory::size() const -> size_t
+{
+    return size_;
+}
+
+auto LeftoverInventory::pieces() const -> std::vector<InventoryPiece>
+{
+    std::vector<InventoryPiece> pieces;
+    pieces.reserve(size_);
+    for (const auto& [height, widths] : index_)
+    {
+        for (const auto& [width, slot] : widths)
+        {
+            pieces.push_back({ file_->record(slot)->serial, { width, height } });
+        }
+    }
+    return pieces;
+}
+
+auto LeftoverInventory::take(const std::pair<Length, Length>& size) -> std::optional<InventoryPiece>
+{
+    auto best_height = index_.end();
+    std::multimap<Length, size_t>::iterator best_width{};
+    Length best_area = 0;
+
+    for (auto height = index_.lower_bound(size.second); height != index_.end(); ++height)
+    {
+        // every piece from here on is at least size.first x height, which cannot beat the best one
+        if (best_height != index_.end() && size.first * height->first >= best_area)
+        {
+            break;
+        }
+
+        const auto width = height->second.lower_bound(size.first);
+        if (width != height->second.end() && (best_height == index_.end() || width->first * height->first < best_area))
+        {
+            best_height = height;
+            best_width = width;
+            best_area = width->first * height->first;
+        }
+    }
+
+    if (best_height == index_.end())
+    {
+        return std::nullopt;
+    }
+
+    const auto slot = best_width->second;
+    best_height->second.erase(best_width);
+    if (best_height->second.empty())
+    {
+        index_.erase(best_height);
+    }
+    size_--;
+    pending_takes_.push_back(slot);
+
+    const auto* record = file_->record(slot);
+    return InventoryPiece{ record->serial, { record->width, record->height } };
+}
+
+void LeftoverInventory::put(const std::pair<Length, Length>& dimensions)
+{
+    if (dimensions.first > 0 && dimensions.second > 0)
+    {
+        pending_puts_.push_back(dimensions);
+    }
+}
+
+void LeftoverInventory::commit()
+{
+    for (const auto slot : pending_takes_)
+    {
+        file_->record(slot)->checksum = 0;
+        free_slots_.push_back(slot);
+    }
+    file_->flush();
+
+    for (const auto& [width, height] : pending_puts_)
+    {
+        const auto slot = acquire_slot();
+        InventoryRecord record{ width, height, next_serial_++, 0 };
+        record.checksum = record_checksum(record);
+        *file_->record(slot) = record;
+        add_to_index(slot);
+    }
+    file_->flush();
+
+    pending_takes_.clear();
+    pending_puts_.clear();
+}
+
+void LeftoverInventory::rollback()
+{
+    for (const auto slot : pending_takes_)
+    {
+        add_to_index(slot);
+    }
+    pending_takes_.clear();
+    pending_puts_.clear();
+}
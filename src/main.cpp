@@ -1,23 +1,37 @@
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <future>
 #include <iomanip>
+#include <optional>
 #include <random>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "cli.h"
+#include "compact_result.h"
 #include "config.h"
 #include "flooring.h"
+#include "layout_metrics.h"
+#include "layout_tables.h"
 #include "plank.h"
 #include "raylib.h"
+#include "units.h"
 
 #define RAYGUI_IMPLEMENTATION
 #pragma warning(push, 0)
 #include "raygui.h"
 #pragma warning(pop)
 
-auto main() -> int
+auto main(int argc, char* argv[]) -> int
 {
+    if (argc > 1)
+    {
+        return run_cli(argc, argv);
+    }
+
     SetConfigFlags(FLAG_WINDOW_RESIZABLE);
     int screenWidth = DEFAULT_WIDTH;
     int screenHeight = DEFAULT_HEIGHT;
@@ -26,23 +40,92 @@ auto main() -> int
 
     Vector2 camera_target{ static_cast<float>(screenWidth) / 2.0f, static_cast<float>(screenHeight) / 2.0f };
 
+    float zoom = 1.0f;
+
+    // the floor is in millimetres, the camera scales it to the screen
     Camera2D camera{};
-    camera.target = camera_target;
+    camera.target = { camera_target.x / DRAW_PIXELS_PER_MILLIMETRE, camera_target.y / DRAW_PIXELS_PER_MILLIMETRE };
     camera.offset = { camera_target.x, camera_target.y };
     camera.rotation = 0.0f;
-    camera.zoom = 1.0f;
+    camera.zoom = zoom * DRAW_PIXELS_PER_MILLIMETRE;
 
     SetTargetFPS(TARGET_FPS);
 
     bool staggered = true;
     bool randomize = false;
+    // reruns lay the planks out the same way as the layout on screen instead of drawing a new seed
+    bool keep_seed = false;
 
     std::pair<int, int> room_size{ DEFAULT_ROOM_SIZE };
     std::pair<int, int> plank_size{ DEFAULT_PLANK_SIZE };
 
-    Flooring flooring;
-    flooring.configure(room_size, plank_size, staggered, randomize);
-    auto result = flooring.calculate();
+    LayoutMetricsCalculator metrics_calculator{ from_centimetres(SHORT_PIECE_LENGTH) };
+    Result result{ 0, 0, 0, {}, {} };
+
+    const auto make_config = [&]() {
+        return FlooringConfig{ from_centimetres(room_size),
+                               from_centimetres(plank_size),
+                               staggered,
+                               randomize,
+                               from_centimetres(DEFAULT_MIN_JOINT_SPACING),
+                               keep_seed ? std::optional{ result.seed } : std::nullopt };
+    };
+    LayoutMetrics metrics{};
+    // the floor on screen, drawn from its row templates; result keeps the counts but not the planks
+    CompactResult layout{ result };
+
+    // a rejected configuration clears the floor and shows the reason instead of the counts
+    std::optional<FlooringError> error{};
+    const auto show_result = [&](FlooringResult calculated) {
+        if (calculated)
+        {
+            result = std::move(*calculated);
+            error.reset();
+        }
+        else
+        {
+            result = { 0, 0, 0, {}, {} };
+            error = calculated.error();
+        }
+        metrics = metrics_calculator.compute(result);
+        layout = CompactResult{ result };
+        result.planks = {};
+    };
+
+    // calculations run on a worker thread so the window stays responsive, the workspace is only touched by the
+    // worker while a run is pending and a new run cancels the previous one at its next row boundary
+    Workspace workspace;
+    CancellationToken cancellation;
+    std::atomic<size_t> rows_done{ 0 };
+    std::atomic<size_t> rows_total{ 0 };
+    workspace.cancellation = &cancellation;
+    workspace.progress = [&](const Progress& progress) {
+        rows_done = progress.rows_done;
+        rows_total = progress.rows_total;
+    };
+
+    std::future<FlooringResult> pending{};
+    // counts of the pending deterministic layout from the precomputed tables, shown before the worker has placed it
+    std::optional<LayoutCounts> table_counts{};
+    const auto stop_calculation = [&]() {
+        if (pending.valid())
+        {
+            cancellation.cancel();
+            (void)pending.get();
+            cancellation.reset();
+        }
+    };
+    const auto start_calculation = [&](bool resume) {
+        stop_calculation();
+        rows_done = 0;
+        rows_total = 0;
+        table_counts = (staggered && !randomize) ? lookup_layout_counts(room_size, plank_size) : std::nullopt;
+        pending = std::async(std::launch::async, [&workspace, config = make_config(), resume]() {
+            return resume ? Flooring::recalculate(config, workspace) : Flooring::calculate(config, workspace);
+        });
+    };
+
+    start_calculation(false);
 
     while (!WindowShouldClose())
     {
@@ -67,29 +150,32 @@ auto main() -> int
         {
             camera_target.y += CAMERA_MOVE_SPEED;
         }
-        camera.target = camera_target;
 
         // Camera zoom controls
-        camera.zoom += (GetMouseWheelMove() * CAMERA_ZOOM_SCALE);
-        if (camera.zoom > CAMERA_ZOOM_MAX)
+        zoom += (GetMouseWheelMove() * CAMERA_ZOOM_SCALE);
+        if (zoom > CAMERA_ZOOM_MAX)
         {
-            camera.zoom = CAMERA_ZOOM_MAX;
+            zoom = CAMERA_ZOOM_MAX;
         }
-        else if (camera.zoom < CAMERA_ZOOM_MIN)
+        else if (zoom < CAMERA_ZOOM_MIN)
         {
-            camera.zoom = CAMERA_ZOOM_MIN;
+            zoom = CAMERA_ZOOM_MIN;
         }
 
         // Camera reset (zoom and rotation)
         if (IsKeyPressed(KEY_R))
         {
-            camera.zoom = 1.0f;
+            zoom = 1.0f;
             camera_target = { static_cast<float>(screenWidth) / 2.0f, static_cast<float>(screenHeight) / 2.0f };
-            camera.target = camera_target;
         }
 
+        camera.target = { camera_target.x / DRAW_PIXELS_PER_MILLIMETRE, camera_target.y / DRAW_PIXELS_PER_MILLIMETRE };
+        camera.zoom = zoom * DRAW_PIXELS_PER_MILLIMETRE;
+
         // Increase / Decrease room size
         // U I O P - fine-tune room size
+        const auto previous_room_size = room_size;
+        const auto previous_plank_size = plank_size;
         if (IsKeyPressed(KEY_U))
         {
             room_size.first = std::max(SLIDER_ROOM_RANGE.first, room_size.first - 1);
@@ -126,22 +212,24 @@ auto main() -> int
             plank_size.second = std::min(SLIDER_PLANK_Y_RANGE.second, plank_size.second + 1);
         }
 
+        if (pending.valid() && pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            show_result(pending.get());
+        }
+
         BeginDrawing();
         ClearBackground(RAYWHITE);
         BeginMode2D(camera);
 
-        for (const auto& plank : result.planks)
-        {
-            plank.draw();
-        }
-        for (const auto& piece : result.left_over_pieces)
+        layout.for_each_plank([](const Plank& plank) { plank.draw(); });
+        for (size_t i = 0; i < result.left_over_pieces.size(); i++)
         {
-            piece.draw();
+            result.left_over_pieces[i].draw(result.left_over_positions[i]);
         }
 
         EndMode2D();
 
-        static constexpr auto blue_rect_height = 460;
+        static constexpr auto blue_rect_height = 500;
         static constexpr auto blue_rect_width = 300;
         static constexpr Color rect_color = { 167u, 199u, 231u, 255u };
         static constexpr auto blue_rect_pos_x = 10;
@@ -201,32 +289,86 @@ auto main() -> int
             static_cast<float>(SLIDER_PLANK_Y_RANGE.first),
             static_cast<float>(SLIDER_PLANK_Y_RANGE.second))));
 
+        // keys and sliders recalculate right away, cancelling the stale run; a change of the room depth only redoes
+        // the rows past the old edge
+        if (room_size != previous_room_size || plank_size != previous_plank_size)
+        {
+            start_calculation(true);
+        }
+
         // display calculation results
-        std::stringstream ss;
-        ss << "Planks needed: " << result.all_planks << '\n'
-           << "Left over pieces: " << result.left_over << '\n'
-           << "Uncut planks: " << result.uncut;
         static constexpr auto result_text_size = 20;
         static constexpr std::pair<int, int> result_text_position{ 40, 270 };
-        DrawText(ss.str().c_str(), result_text_position.first, result_text_position.second, result_text_size, BLACK);
+        const bool counts_from_table = pending.valid() && table_counts;
+        if (error && !counts_from_table)
+        {
+            DrawText(
+                describe(*error),
+                result_text_position.first,
+                result_text_position.second,
+                standard_text_font_size,
+                RED);
+        }
+        else
+        {
+            const auto counts = counts_from_table ? *table_counts
+                                                  : LayoutCounts{ result.all_planks, result.left_over, result.uncut, true };
+            std::stringstream ss;
+            ss << "Planks needed: " << counts.all_planks << '\n'
+               << "Left over pieces: " << counts.left_over << '\n'
+               << "Uncut planks: " << counts.uncut;
+            DrawText(
+                ss.str().c_str(), result_text_position.first, result_text_position.second, result_text_size, BLACK);
+        }
+
+        // display layout quality
+        std::stringstream metrics_ss;
+        metrics_ss << "Min joint offset: " << metrics.min_joint_offset << " mm\n"
+                   << "Average joint offset: " << std::fixed << std::setprecision(1) << metrics.average_joint_offset
+                   << " mm\n"
+                   << "Short pieces: " << metrics.short_pieces << '\n'
+                   << "Repeated rows: " << metrics.repeated_rows << '\n'
+                   << "Seed: " << result.seed;
+        static constexpr std::pair<int, int> metrics_text_position{ 40, 340 };
+        DrawText(
+            metrics_ss.str().c_str(),
+            metrics_text_position.first,
+            metrics_text_position.second,
+            standard_text_font_size,
+            BLACK);
 
         // checkboxes
-        static constexpr Rectangle checkbox1_rect{ 40, 370, 20, 20 };
-        static constexpr Rectangle checkbox2_rect{ 40, 400, 20, 20 };
+        static constexpr Rectangle checkbox1_rect{ 40, 410, 20, 20 };
+        static constexpr Rectangle checkbox2_rect{ 40, 440, 20, 20 };
         staggered = GuiCheckBox(checkbox1_rect, "Stagger Pattern", staggered);
         randomize = GuiCheckBox(checkbox2_rect, "Randomize Lengths", randomize);
+        static constexpr Rectangle checkbox3_rect{ 180, 410, 20, 20 };
+        keep_seed = GuiCheckBox(checkbox3_rect, "Keep Seed", keep_seed);
 
         // Recalculate button
-        static constexpr Rectangle recalculate_button_rect{ 40, 430, 120, 30 };
+        static constexpr Rectangle recalculate_button_rect{ 40, 470, 120, 30 };
         if (GuiButton(recalculate_button_rect, "RECALCULATE"))
         {
-            flooring.configure(room_size, plank_size, staggered, randomize);
-            result = flooring.calculate();
+            start_calculation(false);
+        }
+
+        // progress of the running calculation
+        if (pending.valid())
+        {
+            static constexpr Rectangle progress_bar_rect{ 170, 475, 110, 20 };
+            (void)GuiProgressBar(
+                progress_bar_rect,
+                nullptr,
+                nullptr,
+                static_cast<float>(rows_done.load()),
+                0.0f,
+                static_cast<float>(std::max<size_t>(rows_total.load(), 1)));
         }
 
         EndDrawing();
     }
 
+    stop_calculation();
     CloseWindow();
     return 0;
 }
@@ -0,0 +1,51 @@
+#include "plank_generator.h"
+
+PlankGenerator::PlankGenerator(const Flooring& flooring) : config_(flooring.config())
+{
+}
+
+auto PlankGenerator::begin() -> iterator
+{
+    if (!started_)
+    {
+        started_ = true;
+        error_ = Flooring::validate(config_);
+        if (!error_)
+        {
+            Flooring::start(config_, workspace_);
+            advance();
+        }
+    }
+    return iterator{ this };
+}
+
+auto PlankGenerator::end() -> iterator
+{
+    return iterator{};
+}
+
+auto PlankGenerator::summary() -> Result
+{
+    if (error_)
+    {
+        return { 0, 0, 0, {}, {} };
+    }
+    return Flooring::summary(config_, workspace_);
+}
+
+auto PlankGenerator::error() const -> std::optional<FlooringError>
+{
+    return error_;
+}
+
+void PlankGenerator::advance()
+{
+    if (Flooring::has_next_plank(config_, workspace_))
+    {
+        current_ = Flooring::place_next_plank(config_, workspace_);
+    }
+    else
+    {
+        current_.reset();
+    }
+}
@@ -0,0 +1,15 @@
+#include "plank_writer.h"
+
+CsvPlankWriter::CsvPlankWriter(std::ostream& out) : out_(&out)
+{
+    *out_ << "id,x,y,width,height\n";
+}
+
+void CsvPlankWriter::operator()(const std::vector<Plank>& planks) const
+{
+    for (const auto& p : planks)
+    {
+        *out_ << p.id_ << ',' << p.position_.first << ',' << p.position_.second << ',' << p.dimensions_.first << ','
+              << p.dimensions_.second << '\n';
+    }
+}
@@ -0,0 +1,238 @@
+#include "purchase_planner.h"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    constexpr auto no_cost = std::numeric_limits<std::int64_t>::max();
+
+    [[nodiscard]] auto reserved_planks(const PurchaseJob& job) -> int
+    {
+        static constexpr auto percent = 100;
+        const auto reserve = static_cast<std::int64_t>(job.planks_needed) * job.waste_reserve_percent;
+        return job.planks_needed + static_cast<int>((reserve + percent - 1) / percent);
+    }
+
+    // the whole field as a number, "12abc" or "29.99" are malformed instead of read as 12 and 29
+    template <class Integer>
+    [[nodiscard]] auto parse_whole(const std::string& field) -> Integer
+    {
+        size_t parsed = 0;
+        const auto value = std::stoll(field, &parsed);
+        if (parsed != field.size() || value < std::numeric_limits<Integer>::min() ||
+            value > std::numeric_limits<Integer>::max())
+        {
+            throw std::invalid_argument(field);
+        }
+        return static_cast<Integer>(value);
+    }
+
+    // "30", "29.9" or "29.99" in cents
+    [[nodiscard]] auto parse_price(const std::string& field) -> std::int64_t
+    {
+        static constexpr std::int64_t cents_per_unit = 100;
+        const auto point = field.find('.');
+        const auto units = parse_whole<std::int64_t>(field.substr(0, point));
+        if (units > no_cost / cents_per_unit || units < -no_cost / cents_per_unit)
+        {
+            throw std::out_of_range(field);
+        }
+        if (point == std::string::npos)
+        {
+            return units * cents_per_unit;
+        }
+
+        const auto decimals = field.substr(point + 1);
+        if (decimals.empty() || decimals.size() > 2 ||
+            !std::all_of(begin(decimals), end(decimals), [](char c) { return c >= '0' && c <= '9'; }))
+        {
+            throw std::invalid_argument(field);
+        }
+        const auto cents = parse_whole<std::int64_t>(decimals) * (decimals.size() == 1 ? 10 : 1);
+        // the sign of "-0.50" is only in the text
+        return (field.find('-') < point) ? units * cents_per_unit - cents : units * cents_per_unit + cents;
+    }
+
+    // the fields of every line after the header, count fields each
+    template <class Visitor>
+    void read_csv(std::istream& in, size_t count, const char* kind, Visitor&& visit)
+    {
+        std::string line;
+        std::getline(in, line);
+        for (size_t number = 2; std::getline(in, line); number++)
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+            std::vector<std::string> fields;
+            std::istringstream fields_in{ line };
+            for (std::string field; std::getline(fields_in, field, ',');)
+            {
+                fields.push_back(field);
+            }
+            try
+            {
+                if (fields.size() != count)
+                {
+                    throw std::invalid_argument("field count");
+                }
+                visit(fields);
+            }
+            catch (const std::logic_error&)
+            {
+                throw std::runtime_error("Malformed " + std::string{ kind } + " line " + std::to_string(number));
+            }
+        }
+    }
+}
+
+auto make_purchase_job(const Result& result, int waste_reserve_percent) -> PurchaseJob
+{
+    return { result.all_planks, waste_reserve_percent };
+}
+
+auto read_catalogue(std::istream& in) -> std::vector<Product>
+{
+    std::vector<Product> catalogue;
+    read_csv(in, 3, "catalogue", [&](const std::vector<std::string>& fields) {
+        const auto product = std::find_if(
+            begin(catalogue), end(catalogue), [&](const Product& known) { return known.name == fields[0]; });
+        const BoxOption box{ parse_whole<int>(fields[1]), parse_price(fields[2]) };
+        if (product == end(catalogue))
+        {
+            catalogue.push_back({ fields[0], { box } });
+        }
+        else
+        {
+            product->boxes.push_back(box);
+        }
+    });
+    return catalogue;
+}
+
+auto read_projects(std::istream& in) -> std::vector<PurchaseProject>
+{
+    std::vector<PurchaseProject> projects;
+    read_csv(in, 4, "project", [&](const std::vector<std::string>& fields) {
+        projects.push_back(
+            { fields[0], { parse_whole<int>(fields[1]), parse_whole<int>(fields[2]) }, parse_whole<int>(fields[3]) });
+    });
+    return projects;
+}
+
+PurchasePlanner::PurchasePlanner(std::vector<Product> catalogue) : catalogue_(std::move(catalogue))
+{
+    for (const auto& product : catalogue_)
+    {
+        for (const auto& box : product.boxes)
+        {
+            if (box.price < 0)
+            {
+                throw std::invalid_argument("Negative box price for " + product.name);
+            }
+        }
+    }
+}
+
+auto PurchasePlanner::plan(const std::vector<PurchaseJob>& jobs) const -> std::vector<Purchase>
+{
+    std::vector<Purchase> best(jobs.size());
+
+    for (size_t product = 0; product < catalogue_.size(); product++)
+    {
+        auto purchases = plan_product(product, jobs);
+        for (size_t job = 0; job < jobs.size(); job++)
+        {
+            if (purchases[job].feasible && (!best[job].feasible || purchases[job].price < best[job].price))
+            {
+                best[job] = std::move(purchases[job]);
+            }
+        }
+    }
+
+    return best;
+}
+
+auto PurchasePlanner::plan_product(size_t product, const std::vector<PurchaseJob>& jobs) const -> std::vector<Purchase>
+{
+    const auto& boxes = catalogue_.at(product).boxes;
+    std::vector<Purchase> purchases(jobs.size());
+
+    int largest_box = 0;
+    for (const auto& box : boxes)
+    {
+        largest_box = std::max(largest_box, box.planks_per_box);
+    }
+
+    int largest_job = 0;
+    for (const auto& job : jobs)
+    {
+        largest_job = std::max(largest_job, reserved_planks(job));
+    }
+
+    if (largest_box <= 0 || jobs.empty())
+    {
+        return purchases;
+    }
+
+    // one table per product serves the whole batch: cost[n] is the cheapest way to buy exactly n planks,
+    // anything above largest_job + largest_box can never be the cheapest cover
+    const auto limit = static_cast<size_t>(largest_job) + static_cast<size_t>(largest_box);
+    std::vector<std::int64_t> cost(limit + 1, no_cost);
+    std::vector<int> last_box(limit + 1, -1);
+    cost[0] = 0;
+
+    for (size_t count = 1; count <= limit; count++)
+    {
+        for (size_t b = 0; b < boxes.size(); b++)
+        {
+            const auto size = static_cast<size_t>(boxes[b].planks_per_box);
+            if (size == 0 || size > count || cost[count - size] == no_cost)
+            {
+                continue;
+            }
+            const auto candidate = cost[count - size] + boxes[b].price;
+            if (candidate < cost[count])
+            {
+                cost[count] = candidate;
+                last_box[count] = static_cast<int>(b);
+            }
+        }
+    }
+
+    // cheapest[n] is the exact count m >= n with the lowest cost, so each job is a lookup
+    std::vector<size_t> cheapest(limit + 1, limit);
+    for (size_t count = limit; count-- > 0;)
+    {
+        const auto next = cheapest[count + 1];
+        cheapest[count] = (cost[count] != no_cost && cost[count] <= cost[next]) ? count : next;
+    }
+
+    for (size_t job = 0; job < jobs.size(); job++)
+    {
+        auto count = cheapest[static_cast<size_t>(std::max(0, reserved_planks(jobs[job])))];
+        if (cost[count] == no_cost)
+        {
+            continue;
+        }
+
+        auto& purchase = purchases[job];
+        purchase.feasible = true;
+        purchase.product = product;
+        purchase.planks = static_cast<int>(count);
+        purchase.price = cost[count];
+        purchase.box_counts.assign(boxes.size(), 0);
+        while (count > 0)
+        {
+            const auto b = static_cast<size_t>(last_box[count]);
+            purchase.box_counts[b]++;
+            count -= static_cast<size_t>(boxes[b].planks_per_box);
+        }
+    }
+
+    return purchases;
+}
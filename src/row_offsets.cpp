@@ -0,0 +1,74 @@
+#include "row_offsets.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+void evaluate_row_offsets(
+    Length room_width,
+    std::int32_t plank_length,
+    std::int32_t min_piece,
+    const std::int32_t* offsets,
+    size_t count,
+    std::int32_t* end_cuts,
+    std::int32_t* waste,
+    std::int32_t* short_pieces)
+{
+    // a row starting with a full plank ends at room_width mod plank_length, every offset moves that end back
+    const auto full_row_end = static_cast<std::int32_t>(room_width % plank_length);
+    const auto widest_offset = static_cast<std::int32_t>(std::min<Length>(room_width, plank_length));
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto offset = offsets[i];
+        auto end_cut = full_row_end - offset;
+        end_cut += (end_cut < 0) ? plank_length : 0;
+
+        const bool fits = offset <= widest_offset;
+        const auto offcut = (end_cut > 0) ? plank_length - end_cut : 0;
+        const bool short_first = offset > 0 && offset < min_piece;
+        const bool short_last = end_cut > 0 && end_cut < min_piece;
+
+        end_cuts[i] = fits ? end_cut : 0;
+        waste[i] = fits ? ((offcut < min_piece) ? offcut : 0) : plank_length;
+        short_pieces[i] = (!fits || short_first || short_last) ? 1 : 0;
+    }
+}
+
+auto rank_row_offsets(const FlooringConfig& config, Length min_piece, Length step) -> std::vector<RowOffsetScore>
+{
+    const auto plank_length = config.plank_size.first;
+    if (config.room_size.first <= 0 || plank_length <= 0 || plank_length > std::numeric_limits<std::int32_t>::max() ||
+        step <= 0)
+    {
+        return {};
+    }
+
+    std::vector<std::int32_t> offsets;
+    for (Length offset = 0; offset < plank_length; offset += step)
+    {
+        offsets.push_back(static_cast<std::int32_t>(offset));
+    }
+    std::vector<std::int32_t> end_cuts(offsets.size());
+    std::vector<std::int32_t> waste(offsets.size());
+    std::vector<std::int32_t> short_pieces(offsets.size());
+    evaluate_row_offsets(
+        config.room_size.first,
+        static_cast<std::int32_t>(plank_length),
+        static_cast<std::int32_t>(std::clamp<Length>(min_piece, 0, plank_length)),
+        offsets.data(),
+        offsets.size(),
+        end_cuts.data(),
+        waste.data(),
+        short_pieces.data());
+
+    std::vector<RowOffsetScore> scores;
+    scores.reserve(offsets.size());
+    for (size_t i = 0; i < offsets.size(); i++)
+    {
+        scores.push_back({ offsets[i], end_cuts[i], waste[i], short_pieces[i] != 0 });
+    }
+    std::sort(begin(scores), end(scores), [](const RowOffsetScore& lhs, const RowOffsetScore& rhs) {
+        return std::tie(lhs.short_piece, lhs.waste, lhs.offset) < std::tie(rhs.short_piece, rhs.waste, rhs.offset);
+    });
+    return scores;
+}
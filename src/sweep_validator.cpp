@@ -0,0 +1,120 @@
+#include "sweep_validator.h"
+
+#include <algorithm>
+#include <iterator>
+
+auto SweepValidator::check(const FlooringConfig& config, const Result& result) -> LayoutReport
+{
+    LayoutReport report{};
+    sweep(config.room_size, result.planks, report);
+    report.overused_ids = overused_ids(config, result);
+    return report;
+}
+
+void SweepValidator::sweep(
+    const std::pair<Length, Length>& room_size,
+    const std::vector<Plank>& planks,
+    LayoutReport& report)
+{
+    const auto [room_width, room_depth] = room_size;
+    if (room_width <= 0 || room_depth <= 0)
+    {
+        return;
+    }
+
+    edges_.clear();
+    edges_.reserve(2 * planks.size());
+    for (size_t i = 0; i < planks.size(); i++)
+    {
+        const std::pair<Length, Length> position = planks[i].position_;
+        const std::pair<Length, Length> dimensions = planks[i].dimensions_;
+        if (dimensions.first <= 0 || dimensions.second <= 0 || position.first < 0 || position.second < 0 ||
+            position.first + dimensions.first > room_width || position.second + dimensions.second > room_depth)
+        {
+            report.planks_outside_room++;
+        }
+
+        // the part inside the room still counts towards the coverage
+        const auto x0 = std::max<Length>(position.first, 0);
+        const auto x1 = std::min(position.first + dimensions.first, room_width);
+        const auto y0 = std::max<Length>(position.second, 0);
+        const auto y1 = std::min(position.second + dimensions.second, room_depth);
+        if (x0 < x1 && y0 < y1)
+        {
+            edges_.push_back({ x0, true, i });
+            edges_.push_back({ x1, false, i });
+        }
+    }
+
+    // planks ending at x leave the line before the ones starting there join it
+    std::sort(begin(edges_), end(edges_), [](const Edge& lhs, const Edge& rhs) {
+        return (lhs.x != rhs.x) ? lhs.x < rhs.x : lhs.opens < rhs.opens;
+    });
+
+    on_line_.assign(planks.size(), false);
+    line_.clear();
+    Length covered = 0;
+    Length last_x = 0;
+    for (const auto& edge : edges_)
+    {
+        // the intervals are disjoint and inside the room, so the line is covered when they add up to its depth
+        report.gap_area += (room_depth - covered) * (edge.x - last_x);
+        last_x = edge.x;
+
+        const auto& p = planks[edge.plank];
+        const auto top = std::max<Length>(p.position_.second, 0);
+        const auto bottom = std::min<Length>(p.position_.second + p.dimensions_.second, room_depth);
+        if (!edge.opens)
+        {
+            if (on_line_[edge.plank])
+            {
+                line_.erase(top);
+                covered -= bottom - top;
+            }
+            continue;
+        }
+
+        const auto next = line_.lower_bound(top);
+        const bool hits_next = next != line_.end() && next->first < bottom;
+        const bool hits_previous = next != line_.begin() && std::prev(next)->second > top;
+        if (hits_next || hits_previous)
+        {
+            report.overlapping_planks++;
+            continue;
+        }
+        line_.emplace_hint(next, top, bottom);
+        on_line_[edge.plank] = true;
+        covered += bottom - top;
+    }
+    report.gap_area += room_depth * (room_width - last_x);
+}
+
+auto SweepValidator::overused_ids(const FlooringConfig& config, const Result& result) -> std::vector<int>
+{
+    used_area_.clear();
+    const auto add = [&](const Plank& piece) {
+        if (piece.id_ <= 0 || piece.dimensions_.first <= 0 || piece.dimensions_.second <= 0)
+        {
+            return;
+        }
+        const auto id = static_cast<size_t>(piece.id_);
+        if (id >= used_area_.size())
+        {
+            used_area_.resize(id + 1, 0);
+        }
+        used_area_[id] += static_cast<Length>(piece.dimensions_.first) * piece.dimensions_.second;
+    };
+    std::for_each(begin(result.planks), end(result.planks), add);
+    std::for_each(begin(result.left_over_pieces), end(result.left_over_pieces), add);
+
+    std::vector<int> overused{};
+    const auto plank_area = config.plank_size.first * config.plank_size.second;
+    for (size_t id = 1; id < used_area_.size(); id++)
+    {
+        if (used_area_[id] > plank_area)
+        {
+            overused.push_back(static_cast<int>(id));
+        }
+    }
+    return overused;
+}